@@ -26,11 +26,47 @@ if test "$PHP_LLHTTP" != "no"; then
   dnl Define extension
   AC_DEFINE(HAVE_LLHTTP, 1, [Whether you have llhttp])
   
+  dnl Optional streaming Content-Encoding decoders
+  AC_CHECK_HEADER([zlib.h], [
+    PHP_CHECK_LIBRARY(z, inflateInit2_, [
+      AC_DEFINE(HAVE_LLHTTP_ZLIB, 1, [Whether zlib is available for body decoding])
+      PHP_ADD_LIBRARY(z, 1, LLHTTP_SHARED_LIBADD)
+    ])
+  ])
+  
+  AC_CHECK_HEADER([brotli/decode.h], [
+    PHP_CHECK_LIBRARY(brotlidec, BrotliDecoderCreateInstance, [
+      AC_DEFINE(HAVE_LLHTTP_BROTLI, 1, [Whether brotli is available for body decoding])
+      PHP_ADD_LIBRARY(brotlidec, 1, LLHTTP_SHARED_LIBADD)
+    ])
+  ])
+  
+  dnl Optional native server core
+  AC_CHECK_HEADERS([sys/epoll.h])
+  
+  PHP_SUBST(LLHTTP_SHARED_LIBADD)
+  
   dnl Add all source files including bundled llhttp
   PHP_NEW_EXTENSION(llhttp, 
     php_llhttp.c \
     llhttp_parser.c \
     llhttp_error.c \
+    llhttp_writer.c \
+    llhttp_chunked.c \
+    llhttp_decoder.c \
+    llhttp_url.c \
+    llhttp_form.c \
+    llhttp_multipart.c \
+    llhttp_cookie.c \
+    llhttp_negotiate.c \
+    llhttp_cache.c \
+    llhttp_fingerprint.c \
+    llhttp_timing.c \
+    llhttp_stats.c \
+    llhttp_trace.c \
+    llhttp_events.c \
+    llhttp_connection.c \
+    llhttp_server.c \
     $LLHTTP_SOURCES,
     $ext_shared,, -DZEND_ENABLE_STATIC_TSRMLS_CACHE=1)
   
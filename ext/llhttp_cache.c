@@ -0,0 +1,172 @@
+#include "php_llhttp.h"
+
+ZEND_EXTERN_MODULE_GLOBALS(llhttp)
+
+/* Parse-result cache for byte-identical, bodiless request heads */
+
+static zend_always_inline uint64_t llhttp_hash_read64(const char *p) {
+    uint64_t v;
+    memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+static zend_always_inline uint64_t llhttp_hash_mix(uint64_t a, uint64_t b) {
+#ifdef __SIZEOF_INT128__
+    __uint128_t r = (__uint128_t)a * b;
+    return (uint64_t)r ^ (uint64_t)(r >> 64);
+#else
+    uint64_t r = (a ^ (a >> 32)) * (b | 1);
+    return r ^ (r >> 29);
+#endif
+}
+
+/* wyhash-style 64-bit hash, 16 bytes per step */
+uint64_t llhttp_hash64(const char *p, size_t len) {
+    const uint64_t k0 = 0xa0761d6478bd642fULL, k1 = 0xe7037ed1a0b428dbULL, k2 = 0x8ebc6af09c88c6e3ULL;
+    uint64_t seed = k0 ^ (uint64_t)len;
+    uint64_t tail = 0;
+
+    while (len >= 16) {
+        seed = llhttp_hash_mix(llhttp_hash_read64(p) ^ k1, llhttp_hash_read64(p + 8) ^ seed);
+        p += 16;
+        len -= 16;
+    }
+    if (len >= 8) {
+        seed = llhttp_hash_mix(llhttp_hash_read64(p) ^ k1, seed ^ k2);
+        p += 8;
+        len -= 8;
+    }
+    if (len > 0) {
+        memcpy(&tail, p, len);
+        seed = llhttp_hash_mix(tail ^ k1, seed ^ k0);
+    }
+
+    return llhttp_hash_mix(seed ^ k2, k1);
+}
+
+static void llhttp_head_cache_entry_free(llhttp_head_cache_entry *entry) {
+    if (entry->head) {
+        zend_string_release(entry->head);
+        zend_array_release(entry->headers);
+        if (entry->url) {
+            zend_string_release(entry->url);
+        }
+        if (entry->raw_arena) {
+            efree(entry->raw_arena);
+        }
+        if (entry->raw_headers) {
+            efree(entry->raw_headers);
+        }
+    }
+    memset(entry, 0, sizeof(*entry));
+}
+
+/* Entries hold request memory, so the cache is dropped at request shutdown */
+void llhttp_head_cache_clear(void) {
+    for (int i = 0; i < LLHTTP_HEAD_CACHE_SIZE; i++) {
+        llhttp_head_cache_entry_free(&LLHTTP_G(head_cache)[i]);
+    }
+    LLHTTP_G(head_cache_tick) = 0;
+}
+
+/* Only a fresh parser given exactly one head, ending at the first empty line, is eligible */
+zend_bool llhttp_head_cache_candidate(llhttp_parser_object *intern, zend_string *data) {
+    const char *end;
+
+    /* A cache hit runs no callbacks, so subscribers and the trace ring would miss their events */
+    if (!intern->cache_heads || intern->event_mask || intern->trace_size || intern->state != LLHTTP_STATE_INIT || intern->message_count != 0 ||
+        zend_hash_num_elements(intern->headers) != 0 || intern->url ||
+        ZSTR_LEN(data) < 4 || ZSTR_LEN(data) > LLHTTP_HEAD_CACHE_MAX_LENGTH) {
+        return 0;
+    }
+
+    end = zend_memnstr(ZSTR_VAL(data), "\r\n\r\n", 4, ZSTR_VAL(data) + ZSTR_LEN(data));
+    return end == ZSTR_VAL(data) + ZSTR_LEN(data) - 4;
+}
+
+/* Restore a cached result; headers and URL are shared until written to */
+zend_bool llhttp_head_cache_lookup(llhttp_parser_object *intern, zend_string *data, uint64_t hash) {
+    llhttp_head_cache_entry *entry;
+
+    for (int i = 0; i < LLHTTP_HEAD_CACHE_SIZE; i++) {
+        entry = &LLHTTP_G(head_cache)[i];
+        if (!entry->head || entry->hash != hash || entry->type != intern->type ||
+            entry->parser.lenient_flags != intern->parser.lenient_flags ||
+            !zend_string_equals(entry->head, data)) {
+            continue;
+        }
+        
+        /* A head over this parser's limits must go through llhttp to be rejected */
+        if (LLHTTP_LIMIT_EXCEEDED(intern->max_header_bytes, entry->message_header_bytes) ||
+            LLHTTP_LIMIT_EXCEEDED(intern->max_headers, entry->message_header_count) ||
+            LLHTTP_LIMIT_EXCEEDED(intern->max_url_length, entry->message_url_length)) {
+            return 0;
+        }
+
+        entry->last_used = ++LLHTTP_G(head_cache_tick);
+
+        memcpy(&intern->parser, &entry->parser, sizeof(llhttp_t));
+        intern->parser.data = intern;
+        intern->parser.settings = &intern->settings;
+
+        zend_array_release(intern->headers);
+        GC_ADDREF(entry->headers);
+        intern->headers = entry->headers;
+        intern->url = entry->url ? zend_string_copy(entry->url) : NULL;
+        llhttp_raw_headers_set(intern, entry->raw_arena, entry->raw_arena_used, entry->raw_headers, entry->raw_header_count);
+
+        intern->message_flags = entry->message_flags;
+        intern->message_content_length = entry->message_content_length;
+        intern->message_upgrade = entry->message_upgrade;
+        intern->message_count = 1;
+        intern->message_header_bytes = entry->message_header_bytes;
+        intern->message_header_count = entry->message_header_count;
+        intern->message_url_length = entry->message_url_length;
+        intern->message_body_bytes = 0;
+        intern->fingerprint = entry->fingerprint;
+
+        return 1;
+    }
+
+    return 0;
+}
+
+/* Remember a fresh parse result, evicting the least recently used entry */
+void llhttp_head_cache_store(llhttp_parser_object *intern, zend_string *data, uint64_t hash) {
+    llhttp_head_cache_entry *entry = NULL;
+
+    for (int i = 0; i < LLHTTP_HEAD_CACHE_SIZE; i++) {
+        llhttp_head_cache_entry *candidate = &LLHTTP_G(head_cache)[i];
+        if (!entry || candidate->last_used < entry->last_used) {
+            entry = candidate;
+        }
+    }
+
+    llhttp_head_cache_entry_free(entry);
+
+    entry->head = zend_string_copy(data);
+    entry->hash = hash;
+    entry->type = intern->type;
+    memcpy(&entry->parser, &intern->parser, sizeof(llhttp_t));
+
+    GC_ADDREF(intern->headers);
+    entry->headers = intern->headers;
+    entry->url = intern->url ? zend_string_copy(intern->url) : NULL;
+    if (intern->raw_header_count) {
+        entry->raw_arena = emalloc(intern->raw_arena_used);
+        memcpy(entry->raw_arena, intern->raw_arena, intern->raw_arena_used);
+        entry->raw_arena_used = intern->raw_arena_used;
+        entry->raw_headers = safe_emalloc(intern->raw_header_count, sizeof(llhttp_header_span), 0);
+        memcpy(entry->raw_headers, intern->raw_headers, intern->raw_header_count * sizeof(llhttp_header_span));
+        entry->raw_header_count = intern->raw_header_count;
+    }
+
+    entry->message_flags = intern->message_flags;
+    entry->message_content_length = intern->message_content_length;
+    entry->message_upgrade = intern->message_upgrade;
+    entry->message_header_bytes = intern->message_header_bytes;
+    entry->message_header_count = intern->message_header_count;
+    entry->message_url_length = intern->message_url_length;
+    entry->fingerprint = intern->fingerprint;
+    entry->last_used = ++LLHTTP_G(head_cache_tick);
+}
@@ -0,0 +1,151 @@
+#include "php_llhttp.h"
+
+/* ChunkedEncoder object handlers */
+
+zend_object *llhttp_chunked_encoder_object_create(zend_class_entry *ce) {
+    llhttp_chunked_encoder_object *intern = ecalloc(1, sizeof(llhttp_chunked_encoder_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&intern->std, ce);
+    object_properties_init(&intern->std, ce);
+
+    intern->finished = 0;
+    intern->std.handlers = &llhttp_chunked_encoder_object_handlers;
+
+    return &intern->std;
+}
+
+/* Write the chunk-size line for len into buf, returns bytes written */
+static size_t llhttp_chunked_size_line(char *buf, size_t len) {
+    static const char hex[] = "0123456789abcdef";
+    char digits[sizeof(size_t) * 2];
+    size_t n = 0;
+
+    do {
+        digits[n++] = hex[len & 0xf];
+        len >>= 4;
+    } while (len);
+
+    for (size_t i = 0; i < n; i++) {
+        buf[i] = digits[n - 1 - i];
+    }
+    buf[n] = '\r';
+    buf[n + 1] = '\n';
+
+    return n + 2;
+}
+
+/* ChunkedEncoder class methods */
+
+/* encode(string $data): string */
+PHP_METHOD(LlhttpChunkedEncoder, encode) {
+    zend_string *data;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+        Z_PARAM_STR(data)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_chunked_encoder_object *intern = llhttp_chunked_encoder_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    if (intern->finished) {
+        zend_throw_exception(llhttp_exception_ce, "Chunked stream has already been finished", 0);
+        RETURN_THROWS();
+    }
+
+    /* A zero-length chunk would terminate the stream, so emit nothing */
+    if (ZSTR_LEN(data) == 0) {
+        RETURN_EMPTY_STRING();
+    }
+
+    /* size line + data + CRLF in one allocation */
+    zend_string *result = zend_string_alloc(sizeof(size_t) * 2 + 2 + ZSTR_LEN(data) + 2, 0);
+    char *p = ZSTR_VAL(result);
+
+    p += llhttp_chunked_size_line(p, ZSTR_LEN(data));
+    memcpy(p, ZSTR_VAL(data), ZSTR_LEN(data));
+    p += ZSTR_LEN(data);
+    *p++ = '\r';
+    *p++ = '\n';
+    *p = '\0';
+
+    ZSTR_LEN(result) = p - ZSTR_VAL(result);
+
+    RETURN_NEW_STR(result);
+}
+
+/* finish(array $trailers = []): string */
+PHP_METHOD(LlhttpChunkedEncoder, finish) {
+    HashTable *trailers = NULL;
+    zend_string *name;
+    zval *value;
+    size_t len = sizeof("0\r\n\r\n") - 1;
+
+    ZEND_PARSE_PARAMETERS_START(0, 1)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_ARRAY_HT(trailers)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_chunked_encoder_object *intern = llhttp_chunked_encoder_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    if (intern->finished) {
+        zend_throw_exception(llhttp_exception_ce, "Chunked stream has already been finished", 0);
+        RETURN_THROWS();
+    }
+
+    /* Validate trailers and measure the final buffer */
+    if (trailers) {
+        ZEND_HASH_FOREACH_STR_KEY_VAL(trailers, name, value) {
+            if (!llhttp_is_valid_header_name(name)) {
+                zend_throw_exception(llhttp_exception_ce, "Trailer keys must be valid header names", 0);
+                RETURN_THROWS();
+            }
+            if (Z_TYPE_P(value) != IS_STRING || !llhttp_is_valid_header_value(Z_STR_P(value))) {
+                zend_throw_exception_ex(llhttp_exception_ce, 0, "Trailer \"%s\" must be a string without CR or LF", ZSTR_VAL(name));
+                RETURN_THROWS();
+            }
+            len += ZSTR_LEN(name) + 2 + Z_STRLEN_P(value) + 2;
+        } ZEND_HASH_FOREACH_END();
+    }
+
+    zend_string *result = zend_string_alloc(len, 0);
+    char *p = ZSTR_VAL(result);
+
+    memcpy(p, "0\r\n", 3);
+    p += 3;
+
+    if (trailers) {
+        ZEND_HASH_FOREACH_STR_KEY_VAL(trailers, name, value) {
+            memcpy(p, ZSTR_VAL(name), ZSTR_LEN(name));
+            p += ZSTR_LEN(name);
+            *p++ = ':';
+            *p++ = ' ';
+            memcpy(p, Z_STRVAL_P(value), Z_STRLEN_P(value));
+            p += Z_STRLEN_P(value);
+            *p++ = '\r';
+            *p++ = '\n';
+        } ZEND_HASH_FOREACH_END();
+    }
+
+    *p++ = '\r';
+    *p++ = '\n';
+    *p = '\0';
+
+    intern->finished = 1;
+
+    RETURN_NEW_STR(result);
+}
+
+/* Arginfo for ChunkedEncoder */
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_chunked_encoder_encode, 0, 0, 1)
+    ZEND_ARG_TYPE_INFO(0, data, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_chunked_encoder_finish, 0, 0, 0)
+    ZEND_ARG_TYPE_INFO(0, trailers, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+/* Method entries for ChunkedEncoder class */
+const zend_function_entry llhttp_chunked_encoder_methods[] = {
+    PHP_ME(LlhttpChunkedEncoder, encode, arginfo_llhttp_chunked_encoder_encode, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpChunkedEncoder, finish, arginfo_llhttp_chunked_encoder_finish, ZEND_ACC_PUBLIC)
+    PHP_FE_END
+};
@@ -0,0 +1,324 @@
+#include "php_llhttp.h"
+#include "php_streams.h"
+#if PHP_VERSION_ID >= 80100
+#include "zend_fibers.h"
+#include "zend_interfaces.h"
+#endif
+
+/* Connection object handlers */
+
+zend_object *llhttp_connection_object_create(zend_class_entry *ce) {
+    llhttp_connection_object *intern = ecalloc(1, sizeof(llhttp_connection_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&intern->std, ce);
+    object_properties_init(&intern->std, ce);
+
+    ZVAL_UNDEF(&intern->stream);
+    ZVAL_UNDEF(&intern->parser);
+    intern->buffer = NULL;
+    intern->buffer_size = LLHTTP_CONNECTION_READ_SIZE;
+    intern->buffer_start = 0;
+    intern->buffer_end = 0;
+    intern->closed = 0;
+    intern->std.handlers = &llhttp_connection_object_handlers;
+
+    return &intern->std;
+}
+
+void llhttp_connection_object_free(zend_object *obj) {
+    llhttp_connection_object *intern = llhttp_connection_object_from_zend_object(obj);
+
+    if (Z_TYPE(intern->parser) != IS_UNDEF) {
+        llhttp_parser_object_from_zend_object(Z_OBJ(intern->parser))->pause_on_complete = 0;
+    }
+    if (intern->buffer) {
+        efree(intern->buffer);
+    }
+    zval_ptr_dtor(&intern->stream);
+    zval_ptr_dtor(&intern->parser);
+
+    zend_object_std_dtor(&intern->std);
+}
+
+HashTable *llhttp_connection_object_get_gc(zend_object *obj, zval **table, int *n) {
+    llhttp_connection_object *intern = llhttp_connection_object_from_zend_object(obj);
+
+    *table = &intern->parser;
+    *n = Z_TYPE(intern->parser) != IS_UNDEF ? 1 : 0;
+    return zend_std_get_properties(obj);
+}
+
+/* Read into the connection buffer, which only exists while data is pending */
+static ssize_t llhttp_connection_read(llhttp_connection_object *conn, php_stream *stream, zend_bool blocking) {
+    ssize_t n;
+
+    if (!conn->buffer) {
+        conn->buffer = emalloc(conn->buffer_size);
+    }
+
+    if (blocking) {
+        php_stream_set_option(stream, PHP_STREAM_OPTION_BLOCKING, 1, NULL);
+    }
+    n = php_stream_read(stream, conn->buffer, conn->buffer_size);
+    if (blocking) {
+        php_stream_set_option(stream, PHP_STREAM_OPTION_BLOCKING, 0, NULL);
+    }
+
+    conn->buffer_start = 0;
+    conn->buffer_end = n > 0 ? (size_t)n : 0;
+    return n;
+}
+
+/* Hand control back to the scheduler until the stream is readable; the Connection is the suspend value */
+static zend_result llhttp_connection_suspend(llhttp_connection_object *conn) {
+#if PHP_VERSION_ID >= 80100
+    zval value, retval;
+
+    /* An idle keep-alive connection holds no read buffer */
+    if (conn->buffer) {
+        efree(conn->buffer);
+        conn->buffer = NULL;
+    }
+
+    ZVAL_OBJ(&value, &conn->std);
+    ZVAL_UNDEF(&retval);
+    zend_call_method_with_1_params(NULL, zend_ce_fiber, NULL, "suspend", &retval, &value);
+    zval_ptr_dtor(&retval);
+
+    return EG(exception) ? FAILURE : SUCCESS;
+#else
+    return FAILURE;
+#endif
+}
+
+/* Whether the caller runs inside a Fiber that can be suspended */
+static zend_always_inline zend_bool llhttp_connection_in_fiber(void) {
+#if PHP_VERSION_ID >= 80100
+    return EG(active_fiber) != NULL;
+#else
+    return 0;
+#endif
+}
+
+/* Connection class methods */
+
+/* __construct(resource $stream, Parser $parser, int $readSize = 8192) */
+PHP_METHOD(LlhttpConnection, __construct) {
+    zval *zstream, *zparser;
+    zend_long read_size = LLHTTP_CONNECTION_READ_SIZE;
+    php_stream *stream;
+
+    ZEND_PARSE_PARAMETERS_START(2, 3)
+        Z_PARAM_RESOURCE(zstream)
+        Z_PARAM_OBJECT_OF_CLASS(zparser, llhttp_parser_ce)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_LONG(read_size)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_connection_object *intern = llhttp_connection_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    php_stream_from_zval(stream, zstream);
+
+    if (read_size <= 0 || read_size > LLHTTP_CONNECTION_MAX_READ_SIZE) {
+        zend_throw_exception_ex(llhttp_exception_ce, 0, "Read size must be between 1 and %d bytes", LLHTTP_CONNECTION_MAX_READ_SIZE);
+        RETURN_THROWS();
+    }
+
+    if (Z_TYPE(intern->parser) != IS_UNDEF) {
+        zend_throw_exception(llhttp_exception_ce, "Connection is already constructed", 0);
+        RETURN_THROWS();
+    }
+
+    /* Batched offsets would index the private read buffer, which PHP never sees */
+    if (llhttp_parser_object_from_zend_object(Z_OBJ_P(zparser))->event_mask & LLHTTP_EVENT_BATCH) {
+        zend_throw_exception(llhttp_exception_ce, "Parser option \"batchEvents\" is not supported with Connection", 0);
+        RETURN_THROWS();
+    }
+
+    /* Reads never block the process; a would-block read suspends the Fiber instead */
+    php_stream_set_option(stream, PHP_STREAM_OPTION_BLOCKING, 0, NULL);
+
+    ZVAL_COPY(&intern->stream, zstream);
+    ZVAL_COPY(&intern->parser, zparser);
+    intern->buffer_size = (size_t)read_size;
+}
+
+/* readMessage(): bool */
+PHP_METHOD(LlhttpConnection, readMessage) {
+    php_stream *stream;
+    llhttp_parser_object *parser_obj;
+    llhttp_errno_t err;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_connection_object *intern = llhttp_connection_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    if (Z_TYPE(intern->parser) == IS_UNDEF) {
+        zend_throw_exception(llhttp_exception_ce, "Connection is not constructed", 0);
+        RETURN_THROWS();
+    }
+    if (intern->closed) {
+        RETURN_FALSE;
+    }
+
+    php_stream_from_zval_no_verify(stream, &intern->stream);
+    if (!stream) {
+        zend_throw_exception(llhttp_exception_ce, "Connection stream is closed", 0);
+        RETURN_THROWS();
+    }
+
+    parser_obj = llhttp_parser_object_from_zend_object(Z_OBJ(intern->parser));
+    LLHTTP_CHECK_NOT_EXECUTING(parser_obj, "readMessage");
+    if (parser_obj->finished) {
+        RETURN_FALSE;
+    }
+
+    /* The previous message left the parser paused at its end */
+    if (llhttp_get_errno(&parser_obj->parser) == HPE_PAUSED) {
+        llhttp_resume(&parser_obj->parser);
+        llhttp_parser_clear_message(parser_obj);
+    }
+    parser_obj->pause_on_complete = 1;
+
+    for (;;) {
+        ssize_t n;
+
+        /* Pipelined bytes left over from the previous message come first */
+        if (intern->buffer_start < intern->buffer_end) {
+            const char *data = intern->buffer + intern->buffer_start;
+            size_t length = intern->buffer_end - intern->buffer_start;
+
+            err = llhttp_parser_execute(parser_obj, data, length);
+
+            if (err == HPE_PAUSED) {
+                intern->buffer_start += (size_t)(llhttp_get_error_pos(&parser_obj->parser) - data);
+                parser_obj->state = LLHTTP_STATE_COMPLETE;
+                RETURN_TRUE;
+            }
+            if (err == HPE_PAUSED_UPGRADE) {
+                /* The rest belongs to the upgraded protocol; see getBuffered() */
+                intern->buffer_start += (size_t)(llhttp_get_error_pos(&parser_obj->parser) - data);
+                intern->closed = 1;
+                RETURN_FALSE;
+            }
+            if (err != HPE_OK) {
+                intern->closed = 1;
+                llhttp_parser_throw(parser_obj, err, "Parse error");
+                RETURN_THROWS();
+            }
+            intern->buffer_start = intern->buffer_end = 0;
+        }
+
+        n = llhttp_connection_read(intern, stream, 0);
+        if (n == 0 && !php_stream_eof(stream)) {
+            if (llhttp_connection_in_fiber()) {
+                if (llhttp_connection_suspend(intern) == FAILURE) {
+                    RETURN_THROWS();
+                }
+                continue;
+            }
+
+            /* Outside a Fiber there is nothing else to run, so wait for data */
+            n = llhttp_connection_read(intern, stream, 1);
+        }
+
+        if (n > 0) {
+            llhttp_parser_begin(parser_obj, (size_t)n);
+            continue;
+        }
+        if (n < 0) {
+            intern->closed = 1;
+            zend_throw_exception(llhttp_exception_ce, "Connection read failed", 0);
+            RETURN_THROWS();
+        }
+        if (!php_stream_eof(stream)) {
+            /* Read timeout on a blocking wait; try again */
+            continue;
+        }
+
+        /* The peer closed: complete a message delimited by EOF, or end cleanly between messages */
+        intern->closed = 1;
+        llhttp_parser_begin(parser_obj, 0);
+        parser_obj->executing = 1;
+        err = llhttp_finish(&parser_obj->parser);
+        parser_obj->executing = 0;
+        parser_obj->finished = 1;
+
+        if (err == HPE_PAUSED) {
+            parser_obj->state = LLHTTP_STATE_COMPLETE;
+            RETURN_TRUE;
+        }
+        if (err != HPE_OK) {
+            parser_obj->state = LLHTTP_STATE_ERROR;
+            llhttp_stats_error(err);
+            llhttp_parser_throw(parser_obj, err, "Parse completion error");
+            RETURN_THROWS();
+        }
+        RETURN_FALSE;
+    }
+}
+
+/* getParser(): Parser */
+PHP_METHOD(LlhttpConnection, getParser) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_connection_object *intern = llhttp_connection_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    if (Z_TYPE(intern->parser) == IS_UNDEF) {
+        RETURN_NULL();
+    }
+    RETURN_COPY(&intern->parser);
+}
+
+/* getStream(): mixed */
+PHP_METHOD(LlhttpConnection, getStream) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_connection_object *intern = llhttp_connection_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    if (Z_TYPE(intern->stream) == IS_UNDEF) {
+        RETURN_NULL();
+    }
+    RETURN_COPY(&intern->stream);
+}
+
+/* getBuffered(): string */
+PHP_METHOD(LlhttpConnection, getBuffered) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_connection_object *intern = llhttp_connection_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    if (intern->buffer_start >= intern->buffer_end) {
+        RETURN_EMPTY_STRING();
+    }
+    RETURN_STRINGL(intern->buffer + intern->buffer_start, intern->buffer_end - intern->buffer_start);
+}
+
+/* Arginfo for Connection */
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_connection_construct, 0, 0, 2)
+    ZEND_ARG_INFO(0, stream)
+    ZEND_ARG_OBJ_INFO(0, parser, Llhttp\\Parser, 0)
+    ZEND_ARG_TYPE_INFO(0, readSize, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_connection_readMessage, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_connection_getParser, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_connection_getStream, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_connection_getBuffered, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+/* Method entries for Connection class */
+const zend_function_entry llhttp_connection_methods[] = {
+    PHP_ME(LlhttpConnection, __construct,   arginfo_llhttp_connection_construct, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpConnection, readMessage,   arginfo_llhttp_connection_readMessage, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpConnection, getParser,     arginfo_llhttp_connection_getParser, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpConnection, getStream,     arginfo_llhttp_connection_getStream, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpConnection, getBuffered,   arginfo_llhttp_connection_getBuffered, ZEND_ACC_PUBLIC)
+    PHP_FE_END
+};
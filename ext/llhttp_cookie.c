@@ -0,0 +1,172 @@
+#include "php_llhttp.h"
+
+/* Cookie header parsing (RFC 6265 section 5.4), indexed on first use */
+
+static void llhttp_cookie_add_span(llhttp_parser_object *intern, const char *base, const char *name, const char *name_end,
+                                   const char *value, const char *value_end) {
+    llhttp_cookie_span *span;
+
+    if (intern->cookie_count == intern->cookie_capacity) {
+        intern->cookie_capacity = intern->cookie_capacity ? intern->cookie_capacity * 2 : 8;
+        intern->cookie_spans = safe_erealloc(intern->cookie_spans, intern->cookie_capacity, sizeof(llhttp_cookie_span), 0);
+    }
+
+    span = &intern->cookie_spans[intern->cookie_count++];
+    span->name_offset = name - base;
+    span->name_length = name_end - name;
+    span->value_offset = value - base;
+    span->value_length = value_end - value;
+}
+
+/* Forget the index and decoded values; the span array is kept for reuse */
+void llhttp_cookie_clear(llhttp_parser_object *intern) {
+    if (intern->cookie_source) {
+        zend_string_release(intern->cookie_source);
+        intern->cookie_source = NULL;
+    }
+    intern->cookie_count = 0;
+    intern->cookies_indexed = 0;
+    zend_hash_clean(intern->cookie_values);
+}
+
+/* Build the offset index for the current cookie header, once per header string */
+static void llhttp_cookie_index(llhttp_parser_object *intern) {
+    zval *header = zend_hash_str_find(intern->headers, "cookie", sizeof("cookie") - 1);
+    zend_string *source = (header && Z_TYPE_P(header) == IS_STRING) ? Z_STR_P(header) : NULL;
+    const char *p, *end;
+
+    if (intern->cookies_indexed && intern->cookie_source == source) {
+        return;
+    }
+
+    llhttp_cookie_clear(intern);
+    intern->cookies_indexed = 1;
+
+    if (!source) {
+        return;
+    }
+
+    /* Holding a reference keeps the offsets valid */
+    intern->cookie_source = zend_string_copy(source);
+    p = ZSTR_VAL(source);
+    end = p + ZSTR_LEN(source);
+
+    while (p < end) {
+        const char *pair_end = memchr(p, ';', end - p);
+        const char *name, *name_end, *value, *value_end, *eq;
+
+        if (!pair_end) {
+            pair_end = end;
+        }
+
+        name = p;
+        while (name < pair_end && (*name == ' ' || *name == '\t')) name++;
+        eq = memchr(name, '=', pair_end - name);
+        name_end = eq ? eq : pair_end;
+        while (name_end > name && (name_end[-1] == ' ' || name_end[-1] == '\t')) name_end--;
+
+        if (name_end > name) {
+            value = eq ? eq + 1 : pair_end;
+            value_end = pair_end;
+            while (value < value_end && (*value == ' ' || *value == '\t')) value++;
+            while (value_end > value && (value_end[-1] == ' ' || value_end[-1] == '\t')) value_end--;
+
+            /* A quoted cookie-value is returned without its quotes */
+            if (value_end - value >= 2 && *value == '"' && value_end[-1] == '"') {
+                value++;
+                value_end--;
+            }
+
+            llhttp_cookie_add_span(intern, ZSTR_VAL(source), name, name_end, value, value_end);
+        }
+
+        p = pair_end + 1;
+    }
+}
+
+static zend_bool llhttp_cookie_name_equals(llhttp_parser_object *intern, const llhttp_cookie_span *span, zend_string *name) {
+    const char *raw = ZSTR_VAL(intern->cookie_source) + span->name_offset;
+    zend_string *decoded;
+    zend_bool equal;
+
+    if (llhttp_urlencoded_find_escape(raw, raw + span->name_length) == raw + span->name_length) {
+        return span->name_length == ZSTR_LEN(name) && memcmp(raw, ZSTR_VAL(name), span->name_length) == 0;
+    }
+
+    decoded = llhttp_urldecode(raw, span->name_length);
+    equal = zend_string_equals(decoded, name);
+    zend_string_release(decoded);
+
+    return equal;
+}
+
+/* Decoded value of a cookie, from the cache when it was decoded before */
+static zval *llhttp_cookie_value(llhttp_parser_object *intern, zend_string *name, const llhttp_cookie_span *span) {
+    zval *cached = zend_hash_find(intern->cookie_values, name);
+    zval value;
+
+    if (cached) {
+        return cached;
+    }
+
+    ZVAL_STR(&value, llhttp_urldecode(ZSTR_VAL(intern->cookie_source) + span->value_offset, span->value_length));
+
+    return zend_hash_add_new(intern->cookie_values, name, &value);
+}
+
+/* getCookies(): array */
+PHP_METHOD(LlhttpParser, getCookies) {
+    uint32_t i;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    llhttp_cookie_index(intern);
+
+    array_init_size(return_value, intern->cookie_count);
+
+    for (i = 0; i < intern->cookie_count; i++) {
+        const llhttp_cookie_span *span = &intern->cookie_spans[i];
+        zend_string *name = llhttp_urldecode(ZSTR_VAL(intern->cookie_source) + span->name_offset, span->name_length);
+        zval *value;
+
+        /* The first occurrence of a name wins, as with $_COOKIE */
+        if (!zend_hash_exists(Z_ARRVAL_P(return_value), name)) {
+            value = llhttp_cookie_value(intern, name, span);
+            Z_TRY_ADDREF_P(value);
+            zend_hash_add_new(Z_ARRVAL_P(return_value), name, value);
+        }
+
+        zend_string_release(name);
+    }
+}
+
+/* getCookie(string $name): ?string */
+PHP_METHOD(LlhttpParser, getCookie) {
+    zend_string *name;
+    zval *cached;
+    uint32_t i;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+        Z_PARAM_STR(name)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    llhttp_cookie_index(intern);
+
+    cached = zend_hash_find(intern->cookie_values, name);
+    if (cached) {
+        RETURN_COPY(cached);
+    }
+
+    /* Only the requested value is decoded */
+    for (i = 0; i < intern->cookie_count; i++) {
+        if (llhttp_cookie_name_equals(intern, &intern->cookie_spans[i], name)) {
+            RETURN_COPY(llhttp_cookie_value(intern, name, &intern->cookie_spans[i]));
+        }
+    }
+
+    RETURN_NULL();
+}
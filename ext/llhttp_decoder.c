@@ -0,0 +1,259 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php_llhttp.h"
+
+#ifdef HAVE_LLHTTP_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef HAVE_LLHTTP_BROTLI
+#include <brotli/decode.h>
+#endif
+
+/* Streaming Content-Encoding decoder between on_body and body collection */
+
+#define LLHTTP_DECODER_BUFFER_SIZE 16384
+
+#define LLHTTP_ENCODING_GZIP    1
+#define LLHTTP_ENCODING_DEFLATE 2
+#define LLHTTP_ENCODING_BROTLI  3
+
+struct _llhttp_body_decoder {
+    int encoding;
+    zend_bool initialized;
+    zend_bool done;
+    size_t total_out;
+#ifdef HAVE_LLHTTP_ZLIB
+    z_stream z;
+#endif
+#ifdef HAVE_LLHTTP_BROTLI
+    BrotliDecoderState *br;
+#endif
+};
+
+#ifdef HAVE_LLHTTP_ZLIB
+static voidpf llhttp_zlib_alloc(voidpf opaque, uInt items, uInt size) {
+    return safe_emalloc(items, size, 0);
+}
+
+static void llhttp_zlib_free(voidpf opaque, voidpf address) {
+    efree(address);
+}
+#endif
+
+#ifdef HAVE_LLHTTP_BROTLI
+static void *llhttp_brotli_alloc(void *opaque, size_t size) {
+    return emalloc(size);
+}
+
+static void llhttp_brotli_free(void *opaque, void *address) {
+    if (address) {
+        efree(address);
+    }
+}
+#endif
+
+/* Map a Content-Encoding value to a supported decoder, 0 when unsupported */
+static int llhttp_body_decoder_encoding(zend_string *content_encoding) {
+    const char *start = ZSTR_VAL(content_encoding);
+    const char *end = start + ZSTR_LEN(content_encoding);
+    size_t len;
+
+    while (start < end && (*start == ' ' || *start == '\t')) start++;
+    while (end > start && (end[-1] == ' ' || end[-1] == '\t')) end--;
+    len = end - start;
+
+#ifdef HAVE_LLHTTP_ZLIB
+    if (zend_binary_strcasecmp(start, len, "gzip", sizeof("gzip") - 1) == 0 ||
+        zend_binary_strcasecmp(start, len, "x-gzip", sizeof("x-gzip") - 1) == 0) {
+        return LLHTTP_ENCODING_GZIP;
+    }
+    if (zend_binary_strcasecmp(start, len, "deflate", sizeof("deflate") - 1) == 0) {
+        return LLHTTP_ENCODING_DEFLATE;
+    }
+#endif
+#ifdef HAVE_LLHTTP_BROTLI
+    if (zend_binary_strcasecmp(start, len, "br", sizeof("br") - 1) == 0) {
+        return LLHTTP_ENCODING_BROTLI;
+    }
+#endif
+
+    (void)len;
+    return 0;
+}
+
+llhttp_body_decoder *llhttp_body_decoder_create(zend_string *content_encoding) {
+    int encoding = llhttp_body_decoder_encoding(content_encoding);
+    llhttp_body_decoder *decoder;
+
+    if (!encoding) {
+        return NULL;
+    }
+
+    decoder = ecalloc(1, sizeof(llhttp_body_decoder));
+    decoder->encoding = encoding;
+
+    return decoder;
+}
+
+void llhttp_body_decoder_free(llhttp_body_decoder *decoder) {
+    if (!decoder) {
+        return;
+    }
+
+    if (decoder->initialized) {
+#ifdef HAVE_LLHTTP_ZLIB
+        if (decoder->encoding == LLHTTP_ENCODING_GZIP || decoder->encoding == LLHTTP_ENCODING_DEFLATE) {
+            inflateEnd(&decoder->z);
+        }
+#endif
+#ifdef HAVE_LLHTTP_BROTLI
+        if (decoder->encoding == LLHTTP_ENCODING_BROTLI) {
+            BrotliDecoderDestroyInstance(decoder->br);
+        }
+#endif
+    }
+
+    efree(decoder);
+}
+
+/* Hand decoded bytes on, enforcing the decompressed size limit */
+static int llhttp_body_decoder_emit(llhttp_parser_object *parser_obj, const char *out, size_t length) {
+    llhttp_body_decoder *decoder = parser_obj->decoder;
+
+    if (length == 0) {
+        return HPE_OK;
+    }
+
+    decoder->total_out += length;
+    if (parser_obj->max_decompressed_size > 0 && decoder->total_out > (size_t)parser_obj->max_decompressed_size) {
+        llhttp_set_error_reason(&parser_obj->parser, "Decompressed body exceeds maxDecompressedSize");
+        return HPE_USER;
+    }
+
+    return llhttp_deliver_body(parser_obj, out, length);
+}
+
+/* Lazily set up the stream; deflate is sniffed for a zlib header on the first byte */
+static zend_bool llhttp_body_decoder_init(llhttp_body_decoder *decoder, const char *at) {
+#ifdef HAVE_LLHTTP_ZLIB
+    if (decoder->encoding == LLHTTP_ENCODING_GZIP || decoder->encoding == LLHTTP_ENCODING_DEFLATE) {
+        int window_bits = MAX_WBITS + 16;
+
+        if (decoder->encoding == LLHTTP_ENCODING_DEFLATE) {
+            unsigned char cmf = (unsigned char)at[0];
+            window_bits = ((cmf & 0x0f) == Z_DEFLATED && (cmf >> 4) <= 7) ? MAX_WBITS : -MAX_WBITS;
+        }
+
+        decoder->z.zalloc = llhttp_zlib_alloc;
+        decoder->z.zfree = llhttp_zlib_free;
+        decoder->z.opaque = Z_NULL;
+        if (inflateInit2(&decoder->z, window_bits) != Z_OK) {
+            return 0;
+        }
+    }
+#endif
+#ifdef HAVE_LLHTTP_BROTLI
+    if (decoder->encoding == LLHTTP_ENCODING_BROTLI) {
+        decoder->br = BrotliDecoderCreateInstance(llhttp_brotli_alloc, llhttp_brotli_free, NULL);
+        if (!decoder->br) {
+            return 0;
+        }
+    }
+#endif
+
+    decoder->initialized = 1;
+    return 1;
+}
+
+/* An encoded body must end with its compressed stream; an empty body never started one */
+zend_bool llhttp_body_decoder_finished(llhttp_body_decoder *decoder) {
+    return !decoder->initialized || decoder->done;
+}
+
+int llhttp_body_decoder_feed(llhttp_parser_object *parser_obj, const char *at, size_t length) {
+    llhttp_body_decoder *decoder = parser_obj->decoder;
+    char out[LLHTTP_DECODER_BUFFER_SIZE];
+    int err;
+
+    /* Anything after the end of the compressed stream is ignored */
+    if (decoder->done || length == 0) {
+        return HPE_OK;
+    }
+
+    if (!decoder->initialized && !llhttp_body_decoder_init(decoder, at)) {
+        llhttp_set_error_reason(&parser_obj->parser, "Failed to initialize body decoder");
+        return HPE_USER;
+    }
+
+#ifdef HAVE_LLHTTP_ZLIB
+    if (decoder->encoding == LLHTTP_ENCODING_GZIP || decoder->encoding == LLHTTP_ENCODING_DEFLATE) {
+        z_stream *z = &decoder->z;
+        int status;
+
+        z->next_in = (Bytef *)at;
+        z->avail_in = (uInt)length;
+
+        do {
+            z->next_out = (Bytef *)out;
+            z->avail_out = sizeof(out);
+
+            status = inflate(z, Z_NO_FLUSH);
+            if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR) {
+                llhttp_set_error_reason(&parser_obj->parser, "Invalid compressed body");
+                return HPE_USER;
+            }
+
+            err = llhttp_body_decoder_emit(parser_obj, out, sizeof(out) - z->avail_out);
+            if (err != HPE_OK) {
+                return err;
+            }
+
+            if (status == Z_STREAM_END) {
+                decoder->done = 1;
+                break;
+            }
+            if (status == Z_BUF_ERROR) {
+                break;
+            }
+        } while (z->avail_in > 0 || z->avail_out == 0);
+
+        return HPE_OK;
+    }
+#endif
+#ifdef HAVE_LLHTTP_BROTLI
+    if (decoder->encoding == LLHTTP_ENCODING_BROTLI) {
+        const uint8_t *next_in = (const uint8_t *)at;
+        size_t avail_in = length;
+        BrotliDecoderResult result;
+
+        do {
+            uint8_t *next_out = (uint8_t *)out;
+            size_t avail_out = sizeof(out);
+
+            result = BrotliDecoderDecompressStream(decoder->br, &avail_in, &next_in, &avail_out, &next_out, NULL);
+            if (result == BROTLI_DECODER_RESULT_ERROR) {
+                llhttp_set_error_reason(&parser_obj->parser, "Invalid compressed body");
+                return HPE_USER;
+            }
+
+            err = llhttp_body_decoder_emit(parser_obj, out, sizeof(out) - avail_out);
+            if (err != HPE_OK) {
+                return err;
+            }
+
+            if (result == BROTLI_DECODER_RESULT_SUCCESS) {
+                decoder->done = 1;
+            }
+        } while (result == BROTLI_DECODER_RESULT_NEEDS_MORE_OUTPUT);
+
+        return HPE_OK;
+    }
+#endif
+
+    (void)out;
+    (void)err;
+    return HPE_OK;
+}
@@ -1,50 +1,229 @@
 #include "php_llhttp.h"
 
+/* Event names, indexed by LLHTTP_EVENT_ID_* */
+static const char *llhttp_event_names[LLHTTP_EVENT_COUNT] = {
+    LLHTTP_EVENT_MESSAGE_BEGIN,
+    LLHTTP_EVENT_URL,
+    LLHTTP_EVENT_STATUS,
+    LLHTTP_EVENT_HEADER_FIELD,
+    LLHTTP_EVENT_HEADER_VALUE,
+    LLHTTP_EVENT_HEADERS_COMPLETE,
+    LLHTTP_EVENT_BODY,
+    LLHTTP_EVENT_MESSAGE_COMPLETE
+};
+
+/* Event id for a name, -1 when unknown */
+int llhttp_event_from_name(zend_string *name) {
+    for (int i = 0; i < LLHTTP_EVENT_COUNT; i++) {
+        size_t length = strlen(llhttp_event_names[i]);
+
+        if (ZSTR_LEN(name) == length && memcmp(ZSTR_VAL(name), llhttp_event_names[i], length) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+const char *llhttp_event_name(int event) {
+    return llhttp_event_names[event];
+}
+
+/* Drop all subscriptions */
+void llhttp_events_clear(llhttp_parser_object *parser_obj) {
+    for (int i = 0; i < LLHTTP_EVENT_COUNT; i++) {
+        if (Z_TYPE(parser_obj->event_callbacks[i]) != IS_UNDEF) {
+            zend_release_fcall_info_cache(&parser_obj->event_fcc[i]);
+            zval_ptr_dtor(&parser_obj->event_callbacks[i]);
+            ZVAL_UNDEF(&parser_obj->event_callbacks[i]);
+        }
+    }
+    parser_obj->event_mask &= LLHTTP_EVENT_BATCH;
+}
+
+/* Append a batch record; the buffer only grows, so steady state does not allocate */
+static void llhttp_event_batch_record(llhttp_parser_object *parser_obj, int event, const char *at, size_t length) {
+    llhttp_batch_record *record;
+
+    if (parser_obj->batch_count == parser_obj->batch_capacity) {
+        parser_obj->batch_capacity = parser_obj->batch_capacity ? parser_obj->batch_capacity * 2 : 64;
+        parser_obj->batch = safe_erealloc(parser_obj->batch, parser_obj->batch_capacity, sizeof(llhttp_batch_record), 0);
+    }
+
+    record = &parser_obj->batch[parser_obj->batch_count++];
+    record->offset = (at && parser_obj->parse_base) ? (size_t)(at - parser_obj->parse_base) : SIZE_MAX;
+    record->length = (uint32_t)MIN(length, UINT32_MAX);
+    record->event = (uint8_t)event;
+}
+
+/* Record the event for the batch and/or call a subscribed callback; span events pass their data */
+int llhttp_event_dispatch(llhttp_parser_object *parser_obj, int event, const char *at, size_t length) {
+    zend_fcall_info_cache *fcc = &parser_obj->event_fcc[event];
+    zval args[1], retval;
+    uint32_t argc = 0;
+
+    if (parser_obj->event_mask & LLHTTP_EVENT_BATCH) {
+        llhttp_event_batch_record(parser_obj, event, at, length);
+        if (!(parser_obj->event_mask & LLHTTP_EVENT_BIT(event))) {
+            return 0;
+        }
+    }
+
+    if (at) {
+        ZVAL_STRINGL(&args[0], at, length);
+        argc = 1;
+    }
+    ZVAL_UNDEF(&retval);
+
+    /* The resolved function is reused; only trampolines are resolved per call */
+    if (fcc->function_handler) {
+        zend_call_known_function(fcc->function_handler, fcc->object, fcc->called_scope, &retval, argc, args, NULL);
+    } else {
+        call_user_function(NULL, NULL, &parser_obj->event_callbacks[event], &retval, argc, args);
+    }
+
+    zval_ptr_dtor(&retval);
+    if (argc) {
+        zval_ptr_dtor(&args[0]);
+    }
+
+    if (EG(exception)) {
+        llhttp_set_error_reason(&parser_obj->parser, "Event callback threw an exception");
+        return HPE_USER;
+    }
+
+    return 0;
+}
+
+/* Batch records as [event, ?offset, length] lists */
+void llhttp_events_batch_array(llhttp_parser_object *parser_obj, zval *dest) {
+    array_init_size(dest, parser_obj->batch_count);
+
+    for (uint32_t i = 0; i < parser_obj->batch_count; i++) {
+        const llhttp_batch_record *record = &parser_obj->batch[i];
+        zval entry;
+
+        array_init_size(&entry, 3);
+        add_next_index_string(&entry, llhttp_event_names[record->event]);
+        if (record->offset == SIZE_MAX) {
+            add_next_index_null(&entry);
+        } else {
+            add_next_index_long(&entry, (zend_long)record->offset);
+        }
+        add_next_index_long(&entry, (zend_long)record->length);
+        add_next_index_zval(dest, &entry);
+    }
+}
+
+/* One userland call per parse(): batchEvents callback receives (array $events, string $data) */
+int llhttp_events_batch_deliver(llhttp_parser_object *parser_obj, zend_string *data) {
+    zval args[2], retval;
+    zend_result result;
+
+    if (Z_TYPE(parser_obj->batch_callback) == IS_UNDEF || parser_obj->batch_count == 0) {
+        return SUCCESS;
+    }
+
+    llhttp_events_batch_array(parser_obj, &args[0]);
+    ZVAL_STR_COPY(&args[1], data);
+    ZVAL_UNDEF(&retval);
+
+    result = call_user_function(NULL, NULL, &parser_obj->batch_callback, &retval, 2, args);
+
+    zval_ptr_dtor(&retval);
+    zval_ptr_dtor(&args[0]);
+    zval_ptr_dtor(&args[1]);
+
+    return (result == FAILURE || EG(exception)) ? FAILURE : SUCCESS;
+}
+
+/* getEvents(): array */
+PHP_METHOD(LlhttpParser, getEvents) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    llhttp_events_batch_array(intern, return_value);
+}
+
+/* on(string $event, ?callable $callback): void */
+PHP_METHOD(LlhttpParser, on) {
+    zend_string *name;
+    zend_fcall_info fci;
+    zend_fcall_info_cache fcc;
+    int event;
+
+    ZEND_PARSE_PARAMETERS_START(2, 2)
+        Z_PARAM_STR(name)
+        Z_PARAM_FUNC_OR_NULL(fci, fcc)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    event = llhttp_event_from_name(name);
+    if (event < 0) {
+        zend_throw_exception_ex(llhttp_exception_ce, 0, "Unknown event \"%s\"", ZSTR_VAL(name));
+        RETURN_THROWS();
+    }
+
+    /* A later subscription replaces the earlier one; null unsubscribes */
+    if (Z_TYPE(intern->event_callbacks[event]) != IS_UNDEF) {
+        zend_release_fcall_info_cache(&intern->event_fcc[event]);
+        zval_ptr_dtor(&intern->event_callbacks[event]);
+        ZVAL_UNDEF(&intern->event_callbacks[event]);
+    }
+    intern->event_mask &= ~LLHTTP_EVENT_BIT(event);
+
+    if (!ZEND_FCI_INITIALIZED(fci)) {
+        return;
+    }
+
+    ZVAL_COPY(&intern->event_callbacks[event], &fci.function_name);
+
+    /* A trampoline only lives for one call, so it cannot be cached */
+    if (fcc.function_handler && (fcc.function_handler->common.fn_flags & ZEND_ACC_CALL_VIA_TRAMPOLINE)) {
+        zend_release_fcall_info_cache(&fcc);
+        fcc = empty_fcall_info_cache;
+    }
+    intern->event_fcc[event] = fcc;
+    intern->event_mask |= LLHTTP_EVENT_BIT(event);
+}
+
 /* Events class methods */
 
 /* getAll(): array */
 PHP_METHOD(LlhttpEvents, getAll) {
     ZEND_PARSE_PARAMETERS_NONE();
-    
-    array_init(return_value);
-    
-    add_next_index_string(return_value, LLHTTP_EVENT_MESSAGE_BEGIN);
-    add_next_index_string(return_value, LLHTTP_EVENT_URL);
-    add_next_index_string(return_value, LLHTTP_EVENT_STATUS);
-    add_next_index_string(return_value, LLHTTP_EVENT_HEADER_FIELD);
-    add_next_index_string(return_value, LLHTTP_EVENT_HEADER_VALUE);
-    add_next_index_string(return_value, LLHTTP_EVENT_HEADERS_COMPLETE);
-    add_next_index_string(return_value, LLHTTP_EVENT_BODY);
-    add_next_index_string(return_value, LLHTTP_EVENT_MESSAGE_COMPLETE);
+
+    array_init_size(return_value, LLHTTP_EVENT_COUNT);
+
+    for (int i = 0; i < LLHTTP_EVENT_COUNT; i++) {
+        add_next_index_string(return_value, llhttp_event_names[i]);
+    }
 }
 
 /* isValid(string $event): bool */
 PHP_METHOD(LlhttpEvents, isValid) {
     zend_string *event;
-    
+
     ZEND_PARSE_PARAMETERS_START(1, 1)
         Z_PARAM_STR(event)
     ZEND_PARSE_PARAMETERS_END();
-    
-    const char *event_cstr = ZSTR_VAL(event);
-    
-    if (strcmp(event_cstr, LLHTTP_EVENT_MESSAGE_BEGIN) == 0 ||
-        strcmp(event_cstr, LLHTTP_EVENT_URL) == 0 ||
-        strcmp(event_cstr, LLHTTP_EVENT_STATUS) == 0 ||
-        strcmp(event_cstr, LLHTTP_EVENT_HEADER_FIELD) == 0 ||
-        strcmp(event_cstr, LLHTTP_EVENT_HEADER_VALUE) == 0 ||
-        strcmp(event_cstr, LLHTTP_EVENT_HEADERS_COMPLETE) == 0 ||
-        strcmp(event_cstr, LLHTTP_EVENT_BODY) == 0 ||
-        strcmp(event_cstr, LLHTTP_EVENT_MESSAGE_COMPLETE) == 0) {
-        RETURN_TRUE;
-    }
-    
-    RETURN_FALSE;
+
+    RETURN_BOOL(llhttp_event_from_name(event) >= 0);
 }
 
+/* Arginfo for Events */
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_events_getAll, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_events_isValid, 0, 0, 1)
+    ZEND_ARG_TYPE_INFO(0, event, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
 /* Method entries for Events class */
 const zend_function_entry llhttp_events_methods[] = {
-    PHP_ME(LlhttpEvents, getAll,    NULL, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
-    PHP_ME(LlhttpEvents, isValid,   NULL, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+    PHP_ME(LlhttpEvents, getAll,    arginfo_llhttp_events_getAll, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+    PHP_ME(LlhttpEvents, isValid,   arginfo_llhttp_events_isValid, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
     PHP_FE_END
-};
\ No newline at end of file
+};
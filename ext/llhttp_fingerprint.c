@@ -0,0 +1,109 @@
+#include "php_llhttp.h"
+
+/* Incremental request fingerprint, in the spirit of JA4H */
+
+#define LLHTTP_FNV_OFFSET 0xcbf29ce484222325ULL
+#define LLHTTP_FNV_PRIME  0x100000001b3ULL
+
+static zend_always_inline uint64_t llhttp_fnv1a(uint64_t hash, const char *p, size_t len) {
+    const unsigned char *s = (const unsigned char *)p;
+
+    while (len--) {
+        hash ^= *s++;
+        hash *= LLHTTP_FNV_PRIME;
+    }
+    return hash;
+}
+
+void llhttp_fingerprint_reset(llhttp_fingerprint *fp) {
+    fp->order_hash = LLHTTP_FNV_OFFSET;
+    fp->content_hash = LLHTTP_FNV_OFFSET;
+    fp->header_count = 0;
+    fp->has_cookie = 0;
+    fp->has_referer = 0;
+    memcpy(fp->language, "0000", 4);
+}
+
+/* Fold one completed header in, keeping its original casing and position */
+void llhttp_fingerprint_header(llhttp_fingerprint *fp, zend_string *name, zend_string *value) {
+    fp->content_hash = llhttp_fnv1a(fp->content_hash, ZSTR_VAL(name), ZSTR_LEN(name));
+    fp->content_hash = llhttp_fnv1a(fp->content_hash, ":", 1);
+    fp->content_hash = llhttp_fnv1a(fp->content_hash, ZSTR_VAL(value), ZSTR_LEN(value));
+    fp->content_hash = llhttp_fnv1a(fp->content_hash, "\n", 1);
+
+    /* Cookie and Referer are flags rather than part of the order */
+    if (zend_string_equals_literal_ci(name, "cookie")) {
+        fp->has_cookie = 1;
+        return;
+    }
+    if (zend_string_equals_literal_ci(name, "referer")) {
+        fp->has_referer = 1;
+        return;
+    }
+
+    fp->order_hash = llhttp_fnv1a(fp->order_hash, ZSTR_VAL(name), ZSTR_LEN(name));
+    fp->order_hash = llhttp_fnv1a(fp->order_hash, ",", 1);
+    fp->header_count++;
+
+    /* First four alphanumerics of the primary language, e.g. "en-US" -> "enus" */
+    if (zend_string_equals_literal_ci(name, "accept-language")) {
+        size_t i, n = 0;
+
+        memcpy(fp->language, "0000", 4);
+        for (i = 0; i < ZSTR_LEN(value) && n < 4; i++) {
+            char c = ZSTR_VAL(value)[i];
+            if (c == ',' || c == ';') {
+                break;
+            }
+            if ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9')) {
+                fp->language[n++] = c;
+            } else if (c >= 'A' && c <= 'Z') {
+                fp->language[n++] = c - 'A' + 'a';
+            }
+        }
+    }
+}
+
+static void llhttp_fingerprint_hex(char *buf, uint64_t hash) {
+    static const char digits[] = "0123456789abcdef";
+
+    for (int i = 15; i >= 0; i--) {
+        buf[i] = digits[hash & 0xf];
+        hash >>= 4;
+    }
+    buf[16] = '\0';
+}
+
+/* getFingerprint(): array */
+PHP_METHOD(LlhttpParser, getFingerprint) {
+    const llhttp_fingerprint *fp;
+    char method[2] = { '0', '0' };
+    char summary[sizeof("ge11cr99enus_") - 1 + 12 + 1];
+    char hex[17];
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    fp = &intern->fingerprint;
+
+    if (llhttp_get_type(&intern->parser) == HTTP_REQUEST) {
+        const char *name = llhttp_method_name((llhttp_method_t)llhttp_get_method(&intern->parser));
+
+        method[0] = zend_tolower_ascii(name[0]);
+        method[1] = name[1] ? zend_tolower_ascii(name[1]) : '0';
+    }
+
+    llhttp_fingerprint_hex(hex, fp->order_hash);
+    snprintf(summary, sizeof(summary), "%c%c%u%u%c%c%02u%.4s_%.12s",
+        method[0], method[1],
+        (unsigned)(llhttp_get_http_major(&intern->parser) % 10), (unsigned)(llhttp_get_http_minor(&intern->parser) % 10),
+        fp->has_cookie ? 'c' : 'n', fp->has_referer ? 'r' : 'n',
+        (unsigned)MIN(fp->header_count, 99), fp->language, hex);
+
+    array_init_size(return_value, 4);
+    add_assoc_string(return_value, "fingerprint", summary);
+    add_assoc_string(return_value, "headerOrderHash", hex);
+    llhttp_fingerprint_hex(hex, fp->content_hash);
+    add_assoc_string(return_value, "contentHash", hex);
+    add_assoc_long(return_value, "headerCount", (zend_long)fp->header_count);
+}
@@ -0,0 +1,105 @@
+#include "php_llhttp.h"
+
+/* Incremental application/x-www-form-urlencoded body decoding */
+
+/* Compare the media type of a Content-Type value, ignoring parameters and case */
+zend_bool llhttp_media_type_is(zend_string *content_type, const char *type, size_t type_len) {
+    const char *start = ZSTR_VAL(content_type);
+    const char *end = start + ZSTR_LEN(content_type);
+    const char *semicolon = memchr(start, ';', ZSTR_LEN(content_type));
+
+    if (semicolon) {
+        end = semicolon;
+    }
+    while (start < end && (*start == ' ' || *start == '\t')) start++;
+    while (end > start && (end[-1] == ' ' || end[-1] == '\t')) end--;
+
+    return zend_binary_strcasecmp(start, end - start, type, type_len) == 0;
+}
+
+static int llhttp_form_check_size(llhttp_parser_object *parser_obj, size_t size) {
+    if (parser_obj->max_form_field_size > 0 && size > (size_t)parser_obj->max_form_field_size) {
+        llhttp_set_error_reason(&parser_obj->parser, "Form field exceeds maxFormFieldSize");
+        return HPE_USER;
+    }
+    return HPE_OK;
+}
+
+/* A new pair starts; counted up front so the last pair is limited too */
+static int llhttp_form_start_pair(llhttp_parser_object *parser_obj) {
+    parser_obj->form_fields++;
+    if (parser_obj->max_form_fields > 0 && parser_obj->form_fields > parser_obj->max_form_fields) {
+        llhttp_set_error_reason(&parser_obj->parser, "Form field count exceeds maxFormFields");
+        return HPE_USER;
+    }
+    return HPE_OK;
+}
+
+/* Feed a body span; complete pairs are decoded straight from the span and only
+ * the unfinished tail is buffered, so memory is bounded by the largest field. */
+int llhttp_form_feed(llhttp_parser_object *parser_obj, const char *at, size_t length) {
+    const char *end = at + length;
+    int err;
+
+    while (at < end) {
+        const char *amp = memchr(at, '&', end - at);
+        const char *segment_end = amp ? amp : end;
+        size_t segment_len = segment_end - at;
+
+        if (parser_obj->form_pending) {
+            err = llhttp_form_check_size(parser_obj, ZSTR_LEN(parser_obj->form_pending) + segment_len);
+            if (err != HPE_OK) {
+                return err;
+            }
+            llhttp_append_string(&parser_obj->form_pending, at, segment_len);
+            if (amp) {
+                llhttp_urlencoded_add_pair(parser_obj->form, ZSTR_VAL(parser_obj->form_pending), ZSTR_LEN(parser_obj->form_pending));
+                zend_string_release(parser_obj->form_pending);
+                parser_obj->form_pending = NULL;
+            }
+        } else if (segment_len > 0) {
+            if ((err = llhttp_form_start_pair(parser_obj)) != HPE_OK ||
+                (err = llhttp_form_check_size(parser_obj, segment_len)) != HPE_OK) {
+                return err;
+            }
+            if (amp) {
+                llhttp_urlencoded_add_pair(parser_obj->form, at, segment_len);
+            } else {
+                parser_obj->form_pending = zend_string_init(at, segment_len, 0);
+            }
+        }
+
+        at = amp ? amp + 1 : end;
+    }
+
+    return HPE_OK;
+}
+
+/* Flush the last pair once the body is complete */
+void llhttp_form_finish(llhttp_parser_object *parser_obj) {
+    if (parser_obj->form_pending) {
+        llhttp_urlencoded_add_pair(parser_obj->form, ZSTR_VAL(parser_obj->form_pending), ZSTR_LEN(parser_obj->form_pending));
+        zend_string_release(parser_obj->form_pending);
+        parser_obj->form_pending = NULL;
+    }
+    parser_obj->form_active = 0;
+}
+
+void llhttp_form_clear(llhttp_parser_object *parser_obj) {
+    zend_hash_clean(parser_obj->form);
+    if (parser_obj->form_pending) {
+        zend_string_release(parser_obj->form_pending);
+        parser_obj->form_pending = NULL;
+    }
+    parser_obj->form_active = 0;
+    parser_obj->form_fields = 0;
+}
+
+/* getForm(): array */
+PHP_METHOD(LlhttpParser, getForm) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    RETURN_ARR(zend_array_dup(intern->form));
+}
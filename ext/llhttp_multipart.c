@@ -0,0 +1,524 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php_llhttp.h"
+#include "main/php_open_temporary_file.h"
+
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+
+#include <errno.h>
+
+/* Streaming multipart/form-data decoding (RFC 7578) */
+
+#define LLHTTP_MULTIPART_MAX_BOUNDARY    70
+#define LLHTTP_MULTIPART_MAX_HEADER_SIZE 16384
+
+#define LLHTTP_MULTIPART_PREAMBLE  0
+#define LLHTTP_MULTIPART_DELIMITER 1
+#define LLHTTP_MULTIPART_HEADERS   2
+#define LLHTTP_MULTIPART_BODY      3
+#define LLHTTP_MULTIPART_EPILOGUE  4
+
+struct _llhttp_multipart {
+    int state;
+
+    /* "\r\n--" boundary, with its Horspool shift table */
+    char delimiter[4 + LLHTTP_MULTIPART_MAX_BOUNDARY];
+    size_t delimiter_len;
+    unsigned char shift[256];
+
+    /* Length of a delimiter prefix held back at the end of the previous span */
+    size_t matched;
+    zend_bool dash;
+
+    /* Part being read */
+    zend_string *header_block;
+    zval part;
+    size_t size;
+    zend_string *value;
+    int fd;
+    zend_string *tmp_name;
+};
+
+/* Find a ';'-separated parameter (token or quoted-string) of a header value */
+static zend_bool llhttp_multipart_param(const char *p, size_t len, const char *name, size_t name_len,
+                                        const char **value, size_t *value_len) {
+    const char *end = p + len;
+
+    p = memchr(p, ';', len);
+    while (p && p < end) {
+        const char *key, *key_end, *val, *val_end;
+
+        p++;
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        key = p;
+        while (p < end && *p != '=' && *p != ';') p++;
+        key_end = p;
+        while (key_end > key && (key_end[-1] == ' ' || key_end[-1] == '\t')) key_end--;
+
+        if (p >= end || *p == ';') {
+            continue;
+        }
+
+        p++;
+        while (p < end && (*p == ' ' || *p == '\t')) p++;
+        if (p < end && *p == '"') {
+            val = ++p;
+            while (p < end && *p != '"') {
+                if (*p == '\\' && p + 1 < end) p++;
+                p++;
+            }
+            val_end = p;
+        } else {
+            val = p;
+            while (p < end && *p != ';') p++;
+            val_end = p;
+            while (val_end > val && (val_end[-1] == ' ' || val_end[-1] == '\t')) val_end--;
+        }
+
+        if ((size_t)(key_end - key) == name_len && zend_binary_strncasecmp(key, name_len, name, name_len, name_len) == 0) {
+            *value = val;
+            *value_len = val_end - val;
+            return 1;
+        }
+
+        p = memchr(p, ';', end - p);
+    }
+
+    return 0;
+}
+
+/* Create a decoder for a multipart Content-Type, NULL without a usable boundary */
+llhttp_multipart *llhttp_multipart_create(zend_string *content_type) {
+    llhttp_multipart *mp;
+    const char *boundary;
+    size_t boundary_len, i;
+
+    if (!llhttp_multipart_param(ZSTR_VAL(content_type), ZSTR_LEN(content_type), ZEND_STRL("boundary"), &boundary, &boundary_len) ||
+        boundary_len == 0 || boundary_len > LLHTTP_MULTIPART_MAX_BOUNDARY) {
+        return NULL;
+    }
+
+    mp = ecalloc(1, sizeof(llhttp_multipart));
+    memcpy(mp->delimiter, "\r\n--", 4);
+    memcpy(mp->delimiter + 4, boundary, boundary_len);
+    mp->delimiter_len = 4 + boundary_len;
+
+    memset(mp->shift, (int)mp->delimiter_len, sizeof(mp->shift));
+    for (i = 0; i + 1 < mp->delimiter_len; i++) {
+        mp->shift[(unsigned char)mp->delimiter[i]] = (unsigned char)(mp->delimiter_len - 1 - i);
+    }
+
+    /* The first delimiter may open the body without a preceding CRLF */
+    mp->state = LLHTTP_MULTIPART_PREAMBLE;
+    mp->matched = 2;
+    mp->fd = -1;
+    ZVAL_UNDEF(&mp->part);
+
+    return mp;
+}
+
+/* Release decoder state; a part cut off before its delimiter is dropped */
+void llhttp_multipart_free(llhttp_multipart *mp) {
+    if (!mp) {
+        return;
+    }
+
+    if (mp->fd >= 0) {
+        close(mp->fd);
+    }
+    if (mp->tmp_name) {
+        VCWD_UNLINK(ZSTR_VAL(mp->tmp_name));
+        zend_string_release(mp->tmp_name);
+    }
+    if (mp->value) {
+        zend_string_release(mp->value);
+    }
+    if (mp->header_block) {
+        zend_string_release(mp->header_block);
+    }
+    zval_ptr_dtor(&mp->part);
+
+    efree(mp);
+}
+
+/* Remove temp files of collected parts and forget them */
+void llhttp_multipart_clear_parts(llhttp_parser_object *parser_obj) {
+    zval *part, *tmp_name;
+
+    ZEND_HASH_FOREACH_VAL(parser_obj->parts, part) {
+        tmp_name = zend_hash_str_find(Z_ARRVAL_P(part), "tmpName", sizeof("tmpName") - 1);
+        if (tmp_name && Z_TYPE_P(tmp_name) == IS_STRING) {
+            VCWD_UNLINK(Z_STRVAL_P(tmp_name));
+        }
+    } ZEND_HASH_FOREACH_END();
+
+    zend_hash_clean(parser_obj->parts);
+}
+
+static int llhttp_multipart_call_sink(llhttp_parser_object *parser_obj, const char *data, size_t length, zend_bool final) {
+    llhttp_multipart *mp = parser_obj->multipart;
+    zval args[3], retval;
+    zend_result result;
+
+    ZVAL_COPY(&args[0], &mp->part);
+    ZVAL_STRINGL(&args[1], data, length);
+    ZVAL_BOOL(&args[2], final);
+    ZVAL_UNDEF(&retval);
+
+    result = call_user_function(NULL, NULL, &parser_obj->multipart_sink, &retval, 3, args);
+
+    zval_ptr_dtor(&retval);
+    zval_ptr_dtor(&args[0]);
+    zval_ptr_dtor(&args[1]);
+
+    if (result == FAILURE || EG(exception)) {
+        llhttp_set_error_reason(&parser_obj->parser, "Multipart sink callback failed");
+        return HPE_USER;
+    }
+
+    return HPE_OK;
+}
+
+/* Route part data to the sink callback, a temp file or the in-memory value */
+static int llhttp_multipart_emit(llhttp_parser_object *parser_obj, const char *data, size_t length) {
+    llhttp_multipart *mp = parser_obj->multipart;
+
+    if (mp->state != LLHTTP_MULTIPART_BODY || length == 0) {
+        return HPE_OK;
+    }
+
+    mp->size += length;
+
+    if (!Z_ISUNDEF(parser_obj->multipart_sink)) {
+        return llhttp_multipart_call_sink(parser_obj, data, length, 0);
+    }
+
+    if (mp->fd >= 0) {
+        while (length > 0) {
+            ssize_t written = write(mp->fd, data, length);
+            if (written < 0 && errno == EINTR) {
+                continue;
+            }
+            if (written <= 0) {
+                llhttp_set_error_reason(&parser_obj->parser, "Failed to write multipart temp file");
+                return HPE_USER;
+            }
+            data += written;
+            length -= written;
+        }
+        return HPE_OK;
+    }
+
+    if (parser_obj->max_form_field_size > 0 && mp->size > (size_t)parser_obj->max_form_field_size) {
+        llhttp_set_error_reason(&parser_obj->parser, "Multipart field exceeds maxFormFieldSize");
+        return HPE_USER;
+    }
+    llhttp_append_string(&mp->value, data, length);
+
+    return HPE_OK;
+}
+
+static int llhttp_multipart_finish_part(llhttp_parser_object *parser_obj) {
+    llhttp_multipart *mp = parser_obj->multipart;
+    zval *part = &mp->part;
+    int err = HPE_OK;
+
+    /* The sink may still hold the array passed to it */
+    SEPARATE_ARRAY(part);
+    add_assoc_long(part, "size", (zend_long)mp->size);
+
+    if (!Z_ISUNDEF(parser_obj->multipart_sink)) {
+        err = llhttp_multipart_call_sink(parser_obj, "", 0, 1);
+    } else if (mp->tmp_name) {
+        close(mp->fd);
+        mp->fd = -1;
+        add_assoc_str(part, "tmpName", mp->tmp_name);
+        mp->tmp_name = NULL;
+    } else {
+        add_assoc_str(part, "value", mp->value ? mp->value : ZSTR_EMPTY_ALLOC());
+        mp->value = NULL;
+    }
+
+    zend_hash_next_index_insert(parser_obj->parts, part);
+    ZVAL_UNDEF(&mp->part);
+
+    return err;
+}
+
+static int llhttp_multipart_delimiter_found(llhttp_parser_object *parser_obj) {
+    llhttp_multipart *mp = parser_obj->multipart;
+    int err = HPE_OK;
+
+    if (mp->state == LLHTTP_MULTIPART_BODY) {
+        err = llhttp_multipart_finish_part(parser_obj);
+    }
+
+    mp->state = LLHTTP_MULTIPART_DELIMITER;
+    mp->dash = 0;
+
+    return err;
+}
+
+/* Boyer-Moore-Horspool search for the full delimiter */
+static const char *llhttp_multipart_find(llhttp_multipart *mp, const char *at, size_t length) {
+    size_t dlen = mp->delimiter_len;
+    unsigned char last = (unsigned char)mp->delimiter[dlen - 1];
+    size_t i = 0;
+
+    while (i + dlen <= length) {
+        unsigned char c = (unsigned char)at[i + dlen - 1];
+        if (c == last && memcmp(at + i, mp->delimiter, dlen - 1) == 0) {
+            return at + i;
+        }
+        i += mp->shift[c];
+    }
+
+    return NULL;
+}
+
+/* Emit data up to the next delimiter. A delimiter prefix at the end of the span
+ * is held back; since '\r' only starts the delimiter, held bytes are always a
+ * prefix of it and need no copy. */
+static int llhttp_multipart_scan(llhttp_parser_object *parser_obj, const char **pos, const char *end) {
+    llhttp_multipart *mp = parser_obj->multipart;
+    const char *at = *pos;
+    size_t length = end - at;
+    size_t dlen = mp->delimiter_len;
+    const char *found, *tail;
+    int err;
+
+    if (mp->matched) {
+        size_t need = dlen - mp->matched;
+        size_t n = MIN(need, length);
+
+        if (memcmp(at, mp->delimiter + mp->matched, n) == 0) {
+            if (n < need) {
+                mp->matched += n;
+                *pos = end;
+                return HPE_OK;
+            }
+            mp->matched = 0;
+            *pos = at + n;
+            return llhttp_multipart_delimiter_found(parser_obj);
+        }
+
+        /* Not a delimiter after all, so the held-back bytes were data */
+        err = llhttp_multipart_emit(parser_obj, mp->delimiter, mp->matched);
+        mp->matched = 0;
+        if (err != HPE_OK) {
+            return err;
+        }
+    }
+
+    found = llhttp_multipart_find(mp, at, length);
+    if (found) {
+        err = llhttp_multipart_emit(parser_obj, at, found - at);
+        if (err != HPE_OK) {
+            return err;
+        }
+        *pos = found + dlen;
+        return llhttp_multipart_delimiter_found(parser_obj);
+    }
+
+    tail = at + (length >= dlen ? length - (dlen - 1) : 0);
+    while ((tail = memchr(tail, '\r', end - tail)) != NULL) {
+        if (memcmp(tail, mp->delimiter, end - tail) == 0) {
+            break;
+        }
+        tail++;
+    }
+    if (!tail) {
+        tail = end;
+    }
+
+    *pos = end;
+    err = llhttp_multipart_emit(parser_obj, at, tail - at);
+    mp->matched = end - tail;
+
+    return err;
+}
+
+/* Parse the part header block and set up where its data goes */
+static int llhttp_multipart_begin_body(llhttp_parser_object *parser_obj) {
+    llhttp_multipart *mp = parser_obj->multipart;
+    const char *p = ZSTR_VAL(mp->header_block);
+    const char *end = p + ZSTR_LEN(mp->header_block);
+    const char *param;
+    size_t param_len;
+    zval headers, *disposition;
+    zend_bool is_file = 0;
+
+    array_init(&headers);
+    while (p < end) {
+        const char *line_end = memchr(p, '\n', end - p);
+        const char *colon, *value, *value_end;
+
+        if (!line_end) {
+            line_end = end;
+        }
+        value_end = line_end;
+        if (value_end > p && value_end[-1] == '\r') {
+            value_end--;
+        }
+
+        colon = memchr(p, ':', value_end - p);
+        if (colon && colon > p) {
+            zend_string *name = zend_string_init(p, colon - p, 0);
+            zend_str_tolower(ZSTR_VAL(name), ZSTR_LEN(name));
+
+            value = colon + 1;
+            while (value < value_end && (*value == ' ' || *value == '\t')) value++;
+            while (value_end > value && (value_end[-1] == ' ' || value_end[-1] == '\t')) value_end--;
+
+            add_assoc_stringl_ex(&headers, ZSTR_VAL(name), ZSTR_LEN(name), value, value_end - value);
+            zend_string_release(name);
+        }
+
+        p = line_end + 1;
+    }
+
+    zend_string_release(mp->header_block);
+    mp->header_block = NULL;
+
+    array_init_size(&mp->part, 5);
+    disposition = zend_hash_str_find(Z_ARRVAL(headers), "content-disposition", sizeof("content-disposition") - 1);
+    if (disposition && llhttp_multipart_param(Z_STRVAL_P(disposition), Z_STRLEN_P(disposition), ZEND_STRL("name"), &param, &param_len)) {
+        add_assoc_stringl(&mp->part, "name", param, param_len);
+    } else {
+        add_assoc_null(&mp->part, "name");
+    }
+    if (disposition && llhttp_multipart_param(Z_STRVAL_P(disposition), Z_STRLEN_P(disposition), ZEND_STRL("filename"), &param, &param_len)) {
+        add_assoc_stringl(&mp->part, "filename", param, param_len);
+        is_file = 1;
+    } else {
+        add_assoc_null(&mp->part, "filename");
+    }
+    add_assoc_zval(&mp->part, "headers", &headers);
+
+    mp->size = 0;
+    mp->state = LLHTTP_MULTIPART_BODY;
+
+    if (is_file && Z_ISUNDEF(parser_obj->multipart_sink)) {
+        mp->fd = php_open_temporary_fd(NULL, "llhttp", &mp->tmp_name);
+        if (mp->fd < 0) {
+            llhttp_set_error_reason(&parser_obj->parser, "Failed to create multipart temp file");
+            return HPE_USER;
+        }
+    }
+
+    return HPE_OK;
+}
+
+/* Collect part headers line by line until the empty line */
+static int llhttp_multipart_headers(llhttp_parser_object *parser_obj, const char **pos, const char *end) {
+    llhttp_multipart *mp = parser_obj->multipart;
+    const char *at = *pos;
+    const char *nl = memchr(at, '\n', end - at);
+    const char *chunk_end = nl ? nl + 1 : end;
+    size_t block_len = mp->header_block ? ZSTR_LEN(mp->header_block) : 0;
+    const char *block;
+
+    if (block_len + (chunk_end - at) > LLHTTP_MULTIPART_MAX_HEADER_SIZE) {
+        llhttp_set_error_reason(&parser_obj->parser, "Multipart part headers too large");
+        return HPE_USER;
+    }
+
+    llhttp_append_string(&mp->header_block, at, chunk_end - at);
+    *pos = chunk_end;
+
+    if (!nl) {
+        return HPE_OK;
+    }
+
+    block = ZSTR_VAL(mp->header_block);
+    block_len = ZSTR_LEN(mp->header_block);
+    if ((block_len == 1 && block[0] == '\n') ||
+        (block_len == 2 && block[0] == '\r') ||
+        (block_len >= 2 && block[block_len - 2] == '\n') ||
+        (block_len >= 3 && block[block_len - 3] == '\n' && block[block_len - 2] == '\r')) {
+        return llhttp_multipart_begin_body(parser_obj);
+    }
+
+    return HPE_OK;
+}
+
+/* After a delimiter: "--" closes the body, otherwise a CRLF opens the next part */
+static int llhttp_multipart_after_delimiter(llhttp_parser_object *parser_obj, const char **pos, const char *end) {
+    llhttp_multipart *mp = parser_obj->multipart;
+    const char *at = *pos;
+    int err = HPE_OK;
+
+    while (at < end) {
+        char c = *at++;
+
+        if (mp->dash) {
+            if (c != '-') {
+                err = HPE_USER;
+                break;
+            }
+            mp->state = LLHTTP_MULTIPART_EPILOGUE;
+            break;
+        }
+
+        if (c == '-') {
+            mp->dash = 1;
+        } else if (c == '\n') {
+            if (parser_obj->max_form_fields > 0 && zend_hash_num_elements(parser_obj->parts) >= (uint32_t)parser_obj->max_form_fields) {
+                llhttp_set_error_reason(&parser_obj->parser, "Multipart part count exceeds maxFormFields");
+                *pos = at;
+                return HPE_USER;
+            }
+            mp->state = LLHTTP_MULTIPART_HEADERS;
+            break;
+        } else if (c != ' ' && c != '\t' && c != '\r') {
+            err = HPE_USER;
+            break;
+        }
+    }
+
+    if (err != HPE_OK) {
+        llhttp_set_error_reason(&parser_obj->parser, "Malformed multipart delimiter");
+    }
+    *pos = at;
+
+    return err;
+}
+
+int llhttp_multipart_feed(llhttp_parser_object *parser_obj, const char *at, size_t length) {
+    llhttp_multipart *mp = parser_obj->multipart;
+    const char *end = at + length;
+    int err = HPE_OK;
+
+    while (at < end && err == HPE_OK) {
+        switch (mp->state) {
+            case LLHTTP_MULTIPART_PREAMBLE:
+            case LLHTTP_MULTIPART_BODY:
+                err = llhttp_multipart_scan(parser_obj, &at, end);
+                break;
+            case LLHTTP_MULTIPART_DELIMITER:
+                err = llhttp_multipart_after_delimiter(parser_obj, &at, end);
+                break;
+            case LLHTTP_MULTIPART_HEADERS:
+                err = llhttp_multipart_headers(parser_obj, &at, end);
+                break;
+            default:
+                /* Epilogue is ignored */
+                return HPE_OK;
+        }
+    }
+
+    return err;
+}
+
+/* getParts(): array */
+PHP_METHOD(LlhttpParser, getParts) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    RETURN_ARR(zend_array_dup(intern->parts));
+}
@@ -0,0 +1,254 @@
+#include "php_llhttp.h"
+
+ZEND_EXTERN_MODULE_GLOBALS(llhttp)
+
+/* Content negotiation for Accept, Accept-Encoding and Accept-Language (RFC 9110 section 12) */
+
+#define LLHTTP_NEGOTIATE_MEDIA    0
+#define LLHTTP_NEGOTIATE_TOKEN    1
+#define LLHTTP_NEGOTIATE_LANGUAGE 2
+
+/* Quality in thousandths, from a qvalue such as "0.8" */
+static uint16_t llhttp_negotiate_qvalue(const char *p, const char *end) {
+    uint16_t q = 0, scale = 1000;
+
+    if (p < end && *p == '1') {
+        return 1000;
+    }
+    if (p >= end || *p != '0') {
+        return 1000;
+    }
+    p++;
+    if (p < end && *p == '.') {
+        for (p++; p < end && *p >= '0' && *p <= '9' && scale > 1; p++) {
+            scale /= 10;
+            q += (*p - '0') * scale;
+        }
+    }
+
+    return q;
+}
+
+/* Split a header value into ranges with their q; returns the number found */
+static uint32_t llhttp_negotiate_parse(const char *value, size_t len, llhttp_accept_range *ranges) {
+    const char *p = value, *end = value + len;
+    uint32_t count = 0;
+
+    while (p < end) {
+        const char *element_end = memchr(p, ',', end - p);
+        const char *token, *token_end, *param;
+
+        if (!element_end) {
+            element_end = end;
+        }
+
+        token = p;
+        while (token < element_end && (*token == ' ' || *token == '\t')) token++;
+        token_end = memchr(token, ';', element_end - token);
+        param = token_end;
+        if (!token_end) {
+            token_end = element_end;
+        }
+        while (token_end > token && (token_end[-1] == ' ' || token_end[-1] == '\t')) token_end--;
+
+        if (token_end > token) {
+            llhttp_accept_range *range = &ranges[count++];
+
+            range->offset = (uint32_t)(token - value);
+            range->length = (uint32_t)(token_end - token);
+            range->q = 1000;
+
+            /* Only the q parameter matters for selection */
+            while (param && param < element_end) {
+                param++;
+                while (param < element_end && (*param == ' ' || *param == '\t')) param++;
+                if (element_end - param >= 2 && (*param == 'q' || *param == 'Q') && param[1] == '=') {
+                    range->q = llhttp_negotiate_qvalue(param + 2, element_end);
+                    break;
+                }
+                param = memchr(param, ';', element_end - param);
+            }
+        }
+
+        p = element_end + 1;
+    }
+
+    return count;
+}
+
+/* Parsed ranges for a header value, from the per-worker LRU cache when possible.
+ * Values too long to cache are parsed into *owned, which the caller frees. */
+static const llhttp_accept_range *llhttp_negotiate_ranges(zend_string *value, uint32_t *count, llhttp_accept_range **owned) {
+    zend_ulong hash = zend_string_hash_val(value);
+    llhttp_negotiate_entry *entry, *victim = NULL;
+    llhttp_accept_range *ranges;
+    uint32_t max_ranges = 1, i;
+    size_t j;
+
+    *owned = NULL;
+
+    if (ZSTR_LEN(value) <= LLHTTP_NEGOTIATE_CACHE_MAX_LENGTH) {
+        for (i = 0; i < LLHTTP_NEGOTIATE_CACHE_SIZE; i++) {
+            entry = &LLHTTP_G(negotiate_cache)[i];
+            if (entry->header && entry->hash == hash && zend_string_equals(entry->header, value)) {
+                entry->last_used = ++LLHTTP_G(negotiate_tick);
+                LLHTTP_G(stats).negotiate_cache_hits++;
+                *count = entry->count;
+                return entry->ranges;
+            }
+            if (!victim || entry->last_used < victim->last_used) {
+                victim = entry;
+            }
+        }
+    }
+
+    LLHTTP_G(stats).negotiate_cache_misses++;
+
+    for (j = 0; j < ZSTR_LEN(value); j++) {
+        max_ranges += ZSTR_VAL(value)[j] == ',';
+    }
+    ranges = safe_emalloc(max_ranges, sizeof(llhttp_accept_range), 0);
+    *count = llhttp_negotiate_parse(ZSTR_VAL(value), ZSTR_LEN(value), ranges);
+
+    if (!victim) {
+        *owned = ranges;
+        return ranges;
+    }
+
+    /* Cached entries outlive the request, so they use persistent memory */
+    llhttp_negotiate_entry_free(victim);
+    victim->header = zend_string_init(ZSTR_VAL(value), ZSTR_LEN(value), 1);
+    victim->hash = hash;
+    victim->ranges = pemalloc(MAX(*count, 1) * sizeof(llhttp_accept_range), 1);
+    memcpy(victim->ranges, ranges, *count * sizeof(llhttp_accept_range));
+    victim->count = *count;
+    victim->last_used = ++LLHTTP_G(negotiate_tick);
+    efree(ranges);
+
+    return victim->ranges;
+}
+
+void llhttp_negotiate_entry_free(llhttp_negotiate_entry *entry) {
+    if (entry->header) {
+        zend_string_release(entry->header);
+        pefree(entry->ranges, 1);
+    }
+    memset(entry, 0, sizeof(*entry));
+}
+
+/* Specificity of a range matching a candidate, -1 when it does not match */
+static int llhttp_negotiate_match(int mode, const char *range, size_t range_len, zend_string *candidate) {
+    const char *value = ZSTR_VAL(candidate);
+    size_t value_len = ZSTR_LEN(candidate);
+
+    if (range_len == value_len && zend_binary_strcasecmp(range, range_len, value, value_len) == 0) {
+        return 2;
+    }
+
+    switch (mode) {
+        case LLHTTP_NEGOTIATE_MEDIA: {
+            const char *slash = memchr(value, '/', value_len);
+
+            if (range_len == 3 && memcmp(range, "*/*", 3) == 0) {
+                return 0;
+            }
+            /* A "type/" range ending in a wildcard matches any subtype of that type */
+            if (slash && range_len >= 2 && range[range_len - 2] == '/' && range[range_len - 1] == '*' &&
+                (size_t)(slash - value) == range_len - 2 &&
+                zend_binary_strncasecmp(range, range_len - 2, value, slash - value, range_len - 2) == 0) {
+                return 1;
+            }
+            return -1;
+        }
+        case LLHTTP_NEGOTIATE_LANGUAGE:
+            /* Basic filtering: "en" matches "en-US" */
+            if (range_len < value_len && value[range_len] == '-' &&
+                zend_binary_strncasecmp(range, range_len, value, range_len, range_len) == 0) {
+                return 1;
+            }
+            break;
+    }
+
+    return (range_len == 1 && range[0] == '*') ? 0 : -1;
+}
+
+/* negotiate(string $header, array $available): ?string */
+PHP_METHOD(LlhttpParser, negotiate) {
+    zend_string *header_name, *lower_name;
+    HashTable *available;
+    zval *header, *candidate, *best = NULL;
+    const llhttp_accept_range *ranges;
+    llhttp_accept_range *owned;
+    uint32_t count, i;
+    int mode, best_q = 0;
+
+    ZEND_PARSE_PARAMETERS_START(2, 2)
+        Z_PARAM_STR(header_name)
+        Z_PARAM_ARRAY_HT(available)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    ZEND_HASH_FOREACH_VAL(available, candidate) {
+        if (Z_TYPE_P(candidate) != IS_STRING) {
+            zend_throw_exception(llhttp_exception_ce, "Available values must be strings", 0);
+            RETURN_THROWS();
+        }
+    } ZEND_HASH_FOREACH_END();
+
+    lower_name = zend_string_tolower(header_name);
+    header = zend_hash_find(intern->headers, lower_name);
+    if (zend_string_equals_literal(lower_name, "accept")) {
+        mode = LLHTTP_NEGOTIATE_MEDIA;
+    } else if (zend_string_equals_literal(lower_name, "accept-language")) {
+        mode = LLHTTP_NEGOTIATE_LANGUAGE;
+    } else {
+        mode = LLHTTP_NEGOTIATE_TOKEN;
+    }
+
+    /* Without the header anything is acceptable, so the first preference wins */
+    if (!header || Z_TYPE_P(header) != IS_STRING) {
+        zend_string_release(lower_name);
+        ZEND_HASH_FOREACH_VAL(available, candidate) {
+            RETURN_STR_COPY(Z_STR_P(candidate));
+        } ZEND_HASH_FOREACH_END();
+        RETURN_NULL();
+    }
+
+    ranges = llhttp_negotiate_ranges(Z_STR_P(header), &count, &owned);
+
+    ZEND_HASH_FOREACH_VAL(available, candidate) {
+        int q = -1, specificity = -1;
+
+        /* The most specific matching range decides the quality */
+        for (i = 0; i < count; i++) {
+            int match = llhttp_negotiate_match(mode, Z_STRVAL_P(header) + ranges[i].offset, ranges[i].length, Z_STR_P(candidate));
+            if (match > specificity) {
+                specificity = match;
+                q = ranges[i].q;
+            }
+        }
+
+        /* identity is acceptable unless explicitly refused */
+        if (q < 0) {
+            q = (zend_string_equals_literal(lower_name, "accept-encoding") &&
+                 zend_string_equals_literal_ci(Z_STR_P(candidate), "identity")) ? 1 : 0;
+        }
+
+        /* Ties keep the caller's order of preference */
+        if (q > best_q) {
+            best_q = q;
+            best = candidate;
+        }
+    } ZEND_HASH_FOREACH_END();
+
+    if (owned) {
+        efree(owned);
+    }
+    zend_string_release(lower_name);
+
+    if (best) {
+        RETURN_STR_COPY(Z_STR_P(best));
+    }
+    RETURN_NULL();
+}
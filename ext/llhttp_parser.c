@@ -1,34 +1,150 @@
 #include "php_llhttp.h"
 
+ZEND_EXTERN_MODULE_GLOBALS(llhttp)
+
 /* This function is no longer needed in the new API */
 
 /* Header management functions */
 void llhttp_add_header(llhttp_parser_object *parser_obj, zend_string *field, zend_string *value) {
     zend_string *lower_field;
+    HashTable *target;
     zval header_val;
     
     if (!parser_obj || !parser_obj->headers || !field || !value) {
         return;
     }
     
+    /* Headers after the last chunk are trailers and are kept apart */
+    if (parser_obj->parser.flags & F_TRAILING) {
+        target = parser_obj->trailers;
+    } else {
+        llhttp_headers_separate(parser_obj);
+        target = parser_obj->headers;
+        llhttp_raw_header_add(parser_obj, field, value);
+        llhttp_fingerprint_header(&parser_obj->fingerprint, field, value);
+    }
+    
     /* Simple approach: last header wins, no duplicate handling */
     lower_field = zend_string_tolower(field);
     ZVAL_STR_COPY(&header_val, value);
-    zend_hash_update(parser_obj->headers, lower_field, &header_val);
+    zend_hash_update(target, lower_field, &header_val);
     zend_string_release(lower_field);
 }
 
+/* Headers may be shared with the head cache or getHeaders() callers; copy them before writing */
+void llhttp_headers_separate(llhttp_parser_object *parser_obj) {
+    if (GC_REFCOUNT(parser_obj->headers) > 1) {
+        GC_DELREF(parser_obj->headers);
+        parser_obj->headers = zend_array_dup(parser_obj->headers);
+    }
+}
+
+/* Reserve room in the raw header arena; it only grows, so later messages reuse it */
+static char *llhttp_raw_arena_reserve(llhttp_parser_object *parser_obj, size_t length) {
+    if (parser_obj->raw_arena_size - parser_obj->raw_arena_used < length) {
+        size_t size = MAX(parser_obj->raw_arena_size * 2, 1024);
+        
+        while (size - parser_obj->raw_arena_used < length) {
+            size *= 2;
+        }
+        parser_obj->raw_arena = erealloc(parser_obj->raw_arena, size);
+        LLHTTP_G(stats).reallocations++;
+        parser_obj->raw_arena_size = size;
+    }
+    
+    return parser_obj->raw_arena + parser_obj->raw_arena_used;
+}
+
+static void llhttp_raw_headers_reserve(llhttp_parser_object *parser_obj, uint32_t count) {
+    if (parser_obj->raw_header_capacity < count) {
+        uint32_t capacity = MAX(parser_obj->raw_header_capacity * 2, 32);
+        
+        while (capacity < count) {
+            capacity *= 2;
+        }
+        parser_obj->raw_headers = safe_erealloc(parser_obj->raw_headers, capacity, sizeof(llhttp_header_span), 0);
+        LLHTTP_G(stats).reallocations++;
+        parser_obj->raw_header_capacity = capacity;
+    }
+}
+
+/* Record a header as sent, for getRawHeaders() */
+void llhttp_raw_header_add(llhttp_parser_object *parser_obj, zend_string *field, zend_string *value) {
+    size_t name_length = ZSTR_LEN(field), value_length = ZSTR_LEN(value);
+    llhttp_header_span *span;
+    char *dest;
+    
+    /* Offsets are 32-bit; llhttp would have to accept a 4 GiB head to overflow them */
+    if (parser_obj->raw_arena_used + name_length + value_length > UINT32_MAX) {
+        return;
+    }
+    
+    dest = llhttp_raw_arena_reserve(parser_obj, name_length + value_length);
+    llhttp_raw_headers_reserve(parser_obj, parser_obj->raw_header_count + 1);
+    
+    span = &parser_obj->raw_headers[parser_obj->raw_header_count++];
+    span->name_offset = (uint32_t)parser_obj->raw_arena_used;
+    span->name_length = (uint32_t)name_length;
+    span->value_offset = (uint32_t)(parser_obj->raw_arena_used + name_length);
+    span->value_length = (uint32_t)value_length;
+    
+    memcpy(dest, ZSTR_VAL(field), name_length);
+    memcpy(dest + name_length, ZSTR_VAL(value), value_length);
+    parser_obj->raw_arena_used += name_length + value_length;
+}
+
+/* Replace the raw headers wholesale, as when restoring a cached head */
+void llhttp_raw_headers_set(llhttp_parser_object *parser_obj, const char *arena, size_t used,
+                            const llhttp_header_span *spans, uint32_t count) {
+    parser_obj->raw_arena_used = 0;
+    parser_obj->raw_header_count = 0;
+    
+    if (count == 0) {
+        return;
+    }
+    
+    memcpy(llhttp_raw_arena_reserve(parser_obj, used), arena, used);
+    llhttp_raw_headers_reserve(parser_obj, count);
+    memcpy(parser_obj->raw_headers, spans, count * sizeof(llhttp_header_span));
+    parser_obj->raw_arena_used = used;
+    parser_obj->raw_header_count = count;
+}
+
+void llhttp_clear_chunk_extensions(llhttp_parser_object *parser_obj) {
+    if (parser_obj->chunk_extensions) {
+        zend_array_release(parser_obj->chunk_extensions);
+        parser_obj->chunk_extensions = NULL;
+    }
+    if (parser_obj->chunk_ext_name) {
+        zend_string_release(parser_obj->chunk_ext_name);
+        parser_obj->chunk_ext_name = NULL;
+    }
+    if (parser_obj->chunk_ext_value) {
+        zend_string_release(parser_obj->chunk_ext_value);
+        parser_obj->chunk_ext_value = NULL;
+    }
+    parser_obj->chunk_ext_name_done = 0;
+}
+
 void llhttp_finalize_current_header(llhttp_parser_object *parser_obj) {
     if (!parser_obj) {
         return;
     }
     
-    if (parser_obj->current_header_field && parser_obj->current_header_value) {
+    if (parser_obj->current_header_field) {
+        /* A header with an empty value never sees a value span */
+        if (!parser_obj->current_header_value) {
+            parser_obj->current_header_value = ZSTR_EMPTY_ALLOC();
+        }
+        
         llhttp_add_header(parser_obj, parser_obj->current_header_field, parser_obj->current_header_value);
         
         zend_string_release(parser_obj->current_header_field);
-        zend_string_release(parser_obj->current_header_value);
         parser_obj->current_header_field = NULL;
+    }
+    
+    if (parser_obj->current_header_value) {
+        zend_string_release(parser_obj->current_header_value);
         parser_obj->current_header_value = NULL;
     }
 }
@@ -36,7 +152,32 @@ void llhttp_finalize_current_header(llhttp_parser_object *parser_obj) {
 /* llhttp callback functions */
 
 int llhttp_on_message_begin_cb(llhttp_t *parser) {
-    /* No event emission needed in new API */
+    llhttp_parser_object *parser_obj = (llhttp_parser_object *)parser->data;
+    
+    if (!parser_obj) {
+        return 0;
+    }
+    
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_MESSAGE_BEGIN, NULL, 0);
+    
+    /* Limits apply per message */
+    parser_obj->message_header_bytes = 0;
+    parser_obj->message_header_count = 0;
+    parser_obj->message_url_length = 0;
+    parser_obj->message_body_bytes = 0;
+    
+    /* Callbacks reuse the clock reading taken once per parse() call */
+    parser_obj->timing_first_byte = parser_obj->parse_time;
+    parser_obj->timing_headers_complete = 0;
+    parser_obj->timing_message_complete = 0;
+    
+    /* Raw headers and the fingerprint describe the latest message only */
+    parser_obj->raw_arena_used = 0;
+    parser_obj->raw_header_count = 0;
+    llhttp_fingerprint_reset(&parser_obj->fingerprint);
+    
+    LLHTTP_EMIT(parser_obj, LLHTTP_EVENT_ID_MESSAGE_BEGIN, NULL, 0);
+    
     return 0;
 }
 
@@ -47,14 +188,36 @@ int llhttp_on_url_cb(llhttp_t *parser, const char *at, size_t length) {
         return 0;
     }
     
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_URL, at, length);
+    
+    parser_obj->message_url_length += length;
+    if (LLHTTP_LIMIT_EXCEEDED(parser_obj->max_url_length, parser_obj->message_url_length)) {
+        llhttp_set_error_reason(parser, "URL exceeds maxUrlLength");
+        return HPE_USER;
+    }
+    
     /* Store URL data for getUrl() */
     llhttp_append_url(parser_obj, at, length);
     
+    LLHTTP_EMIT(parser_obj, LLHTTP_EVENT_ID_URL, at, length);
+    
     return 0;
 }
 
 int llhttp_on_status_cb(llhttp_t *parser, const char *at, size_t length) {
-    /* Status text not needed in new API - use getStatusCode() instead */
+    llhttp_parser_object *parser_obj = (llhttp_parser_object *)parser->data;
+    
+    if (!parser_obj) {
+        return 0;
+    }
+    
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_STATUS, at, length);
+    
+    /* Status text is only passed to subscribers - use getStatusCode() instead */
+    if (at && length > 0) {
+        LLHTTP_EMIT(parser_obj, LLHTTP_EVENT_ID_STATUS, at, length);
+    }
+    
     return 0;
 }
 
@@ -65,11 +228,27 @@ int llhttp_on_header_field_cb(llhttp_t *parser, const char *at, size_t length) {
         return 0;
     }
     
-    /* Store current header field for getHeaders() */
-    if (parser_obj->current_header_field) {
-        zend_string_release(parser_obj->current_header_field);
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_HEADER_FIELD, at, length);
+    
+    /* The first span of a field starts a new header */
+    if (!parser_obj->current_header_field) {
+        parser_obj->message_header_count++;
+        if (LLHTTP_LIMIT_EXCEEDED(parser_obj->max_headers, parser_obj->message_header_count)) {
+            llhttp_set_error_reason(parser, "Header count exceeds maxHeaders");
+            return HPE_USER;
+        }
+    }
+    
+    parser_obj->message_header_bytes += length;
+    if (LLHTTP_LIMIT_EXCEEDED(parser_obj->max_header_bytes, parser_obj->message_header_bytes)) {
+        llhttp_set_error_reason(parser, "Header section exceeds maxHeaderBytes");
+        return HPE_USER;
     }
-    parser_obj->current_header_field = zend_string_init(at, length, 0);
+    
+    /* Field may arrive in several spans when split across parse() calls */
+    llhttp_append_string(&parser_obj->current_header_field, at, length);
+    
+    LLHTTP_EMIT(parser_obj, LLHTTP_EVENT_ID_HEADER_FIELD, at, length);
     
     return 0;
 }
@@ -81,44 +260,279 @@ int llhttp_on_header_value_cb(llhttp_t *parser, const char *at, size_t length) {
         return 0;
     }
     
-    /* Store header value and add to collection if we have a field */
-    if (parser_obj->current_header_field) {
-        zend_string *value = zend_string_init(at, length, 0);
-        zend_string *lower_field = zend_string_tolower(parser_obj->current_header_field);
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_HEADER_VALUE, at, length);
+    
+    parser_obj->message_header_bytes += length;
+    if (LLHTTP_LIMIT_EXCEEDED(parser_obj->max_header_bytes, parser_obj->message_header_bytes)) {
+        llhttp_set_error_reason(parser, "Header section exceeds maxHeaderBytes");
+        return HPE_USER;
+    }
+    
+    /* Value is stored once complete, see llhttp_on_header_value_complete_cb() */
+    llhttp_append_string(&parser_obj->current_header_value, at, length);
+    
+    LLHTTP_EMIT(parser_obj, LLHTTP_EVENT_ID_HEADER_VALUE, at, length);
+    
+    return 0;
+}
+
+int llhttp_on_header_value_complete_cb(llhttp_t *parser) {
+    llhttp_parser_object *parser_obj = (llhttp_parser_object *)parser->data;
+    
+    if (!parser_obj) {
+        return 0;
+    }
+    
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_HEADER_COMPLETE, NULL, 0);
+    
+    /* Store header for getHeaders(), or getTrailers() once F_TRAILING is set */
+    llhttp_finalize_current_header(parser_obj);
+    
+    return 0;
+}
+
+int llhttp_on_headers_complete_cb(llhttp_t *parser) {
+    llhttp_parser_object *parser_obj = (llhttp_parser_object *)parser->data;
+    
+    if (!parser_obj) {
+        return 0;
+    }
+    
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_HEADERS_COMPLETE, NULL, 0);
+    
+    parser_obj->timing_headers_complete = parser_obj->parse_time;
+    llhttp_stats_headers(parser_obj->message_header_count);
+    
+    /* llhttp resets flags after the message, so keep what the headers said */
+    parser_obj->message_flags = parser->flags;
+    parser_obj->message_content_length = parser->content_length;
+    parser_obj->message_upgrade = parser->upgrade;
+    
+    /* Decode form bodies as they stream in instead of collecting them */
+    if (parser_obj->parse_form || parser_obj->parse_multipart) {
+        zval *content_type = zend_hash_str_find(parser_obj->headers, "content-type", sizeof("content-type") - 1);
         
-        /* Simple header storage - last value wins */
-        zval header_val;
-        ZVAL_STR_COPY(&header_val, value);
-        zend_hash_update(parser_obj->headers, lower_field, &header_val);
+        if (content_type && Z_TYPE_P(content_type) == IS_STRING) {
+            if (parser_obj->parse_form &&
+                llhttp_media_type_is(Z_STR_P(content_type), ZEND_STRL("application/x-www-form-urlencoded"))) {
+                parser_obj->form_active = 1;
+            } else if (parser_obj->parse_multipart && !parser_obj->multipart &&
+                       llhttp_media_type_is(Z_STR_P(content_type), ZEND_STRL("multipart/form-data"))) {
+                parser_obj->multipart = llhttp_multipart_create(Z_STR_P(content_type));
+            }
+        }
+    }
+    parser_obj->body_streamed = parser_obj->form_active || parser_obj->multipart;
+    
+    /* Set up streaming decompression when requested and supported */
+    if (parser_obj->decompress && !parser_obj->decoder) {
+        zval *encoding = zend_hash_str_find(parser_obj->headers, "content-encoding", sizeof("content-encoding") - 1);
         
-        zend_string_release(value);
-        zend_string_release(lower_field);
-        zend_string_release(parser_obj->current_header_field);
-        parser_obj->current_header_field = NULL;
+        if (encoding && Z_TYPE_P(encoding) == IS_STRING) {
+            parser_obj->decoder = llhttp_body_decoder_create(Z_STR_P(encoding));
+            parser_obj->body_decoded = parser_obj->decoder != NULL;
+        }
     }
     
+    /* Subscribers see the complete header table */
+    LLHTTP_EMIT(parser_obj, LLHTTP_EVENT_ID_HEADERS_COMPLETE, NULL, 0);
+    
     return 0;
 }
 
-int llhttp_on_headers_complete_cb(llhttp_t *parser) {
-    /* Headers are collected automatically - no event needed */
+/* Final body sink, after any Content-Encoding decoding */
+int llhttp_deliver_body(llhttp_parser_object *parser_obj, const char *at, size_t length) {
+    if (parser_obj->form_active) {
+        return llhttp_form_feed(parser_obj, at, length);
+    }
+    if (parser_obj->multipart) {
+        return llhttp_multipart_feed(parser_obj, at, length);
+    }
+    
+    /* Store body data for getBody() */
+    llhttp_append_body(parser_obj, at, length);
+    
     return 0;
 }
 
 int llhttp_on_body_cb(llhttp_t *parser, const char *at, size_t length) {
     llhttp_parser_object *parser_obj = (llhttp_parser_object *)parser->data;
+    int err;
     
     if (!parser_obj || !at || length == 0) {
         return 0;
     }
     
-    /* Store body data for getBody() */
-    llhttp_append_body(parser_obj, at, length);
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_BODY, at, length);
+    
+    /* Checked on the bytes as sent, before any decoding or buffering */
+    parser_obj->message_body_bytes += length;
+    LLHTTP_G(stats).body_bytes += length;
+    if (LLHTTP_LIMIT_EXCEEDED(parser_obj->max_body_size, parser_obj->message_body_bytes)) {
+        llhttp_set_error_reason(parser, "Body exceeds maxBodySize");
+        return HPE_USER;
+    }
+    
+    parser_obj->body_length += length;
+    
+    /* Decode before collecting so the compressed copy is never kept */
+    err = parser_obj->decoder ? llhttp_body_decoder_feed(parser_obj, at, length) : llhttp_deliver_body(parser_obj, at, length);
+    if (err) {
+        return err;
+    }
+    
+    /* Subscribers get the body as sent */
+    LLHTTP_EMIT(parser_obj, LLHTTP_EVENT_ID_BODY, at, length);
     
     return 0;
 }
 
 int llhttp_on_message_complete_cb(llhttp_t *parser) {
-    /* Message completion handled by state management - no event needed */
+    llhttp_parser_object *parser_obj = (llhttp_parser_object *)parser->data;
+    
+    if (!parser_obj) {
+        return 0;
+    }
+    
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_MESSAGE_COMPLETE, NULL, 0);
+    
+    /* getBody() would otherwise return a prefix of the payload as if it were whole */
+    if (parser_obj->decoder && !llhttp_body_decoder_finished(parser_obj->decoder)) {
+        llhttp_set_error_reason(parser, "Truncated compressed body");
+        return HPE_USER;
+    }
+    
+    parser_obj->message_count++;
+    LLHTTP_G(stats).messages++;
+    parser_obj->timing_message_complete = parser_obj->parse_time;
+    
+    /* Release decoder state as soon as the body is done */
+    if (parser_obj->decoder) {
+        llhttp_body_decoder_free(parser_obj->decoder);
+        parser_obj->decoder = NULL;
+    }
+    
+    if (parser_obj->form_active) {
+        llhttp_form_finish(parser_obj);
+    }
+    if (parser_obj->multipart) {
+        llhttp_multipart_free(parser_obj->multipart);
+        parser_obj->multipart = NULL;
+    }
+    
+    LLHTTP_EMIT(parser_obj, LLHTTP_EVENT_ID_MESSAGE_COMPLETE, NULL, 0);
+    
+    /* A Connection hands over one message at a time */
+    if (parser_obj->pause_on_complete) {
+        return HPE_PAUSED;
+    }
+    
     return 0;
-}
\ No newline at end of file
+}
+
+/* Chunk extensions arrive before on_chunk_header, so they are staged per chunk */
+int llhttp_on_chunk_extension_name_cb(llhttp_t *parser, const char *at, size_t length) {
+    llhttp_parser_object *parser_obj = (llhttp_parser_object *)parser->data;
+    
+    if (!parser_obj || !at || length == 0) {
+        return 0;
+    }
+    
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_CHUNK_EXTENSION_NAME, at, length);
+    
+    /* A completed name means this span starts the next extension */
+    if (parser_obj->chunk_ext_name_done) {
+        zend_string_release(parser_obj->chunk_ext_name);
+        parser_obj->chunk_ext_name = NULL;
+        parser_obj->chunk_ext_name_done = 0;
+    }
+    
+    llhttp_append_string(&parser_obj->chunk_ext_name, at, length);
+    
+    return 0;
+}
+
+int llhttp_on_chunk_extension_name_complete_cb(llhttp_t *parser) {
+    llhttp_parser_object *parser_obj = (llhttp_parser_object *)parser->data;
+    zval ext_val;
+    
+    if (!parser_obj || !parser_obj->chunk_ext_name) {
+        return 0;
+    }
+    
+    if (!parser_obj->chunk_extensions) {
+        parser_obj->chunk_extensions = zend_new_array(0);
+    }
+    
+    /* Extensions without a value are recorded as null */
+    ZVAL_NULL(&ext_val);
+    zend_symtable_update(parser_obj->chunk_extensions, parser_obj->chunk_ext_name, &ext_val);
+    parser_obj->chunk_ext_name_done = 1;
+    
+    return 0;
+}
+
+int llhttp_on_chunk_extension_value_cb(llhttp_t *parser, const char *at, size_t length) {
+    llhttp_parser_object *parser_obj = (llhttp_parser_object *)parser->data;
+    
+    if (!parser_obj || !at || length == 0) {
+        return 0;
+    }
+    
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_CHUNK_EXTENSION_VALUE, at, length);
+    
+    llhttp_append_string(&parser_obj->chunk_ext_value, at, length);
+    
+    return 0;
+}
+
+int llhttp_on_chunk_extension_value_complete_cb(llhttp_t *parser) {
+    llhttp_parser_object *parser_obj = (llhttp_parser_object *)parser->data;
+    zval ext_val;
+    
+    if (!parser_obj || !parser_obj->chunk_ext_name || !parser_obj->chunk_extensions) {
+        return 0;
+    }
+    
+    if (parser_obj->chunk_ext_value) {
+        ZVAL_STR(&ext_val, parser_obj->chunk_ext_value);
+        parser_obj->chunk_ext_value = NULL;
+    } else {
+        ZVAL_EMPTY_STRING(&ext_val);
+    }
+    zend_symtable_update(parser_obj->chunk_extensions, parser_obj->chunk_ext_name, &ext_val);
+    
+    return 0;
+}
+
+int llhttp_on_chunk_header_cb(llhttp_t *parser) {
+    llhttp_parser_object *parser_obj = (llhttp_parser_object *)parser->data;
+    zval chunk, extensions;
+    
+    if (!parser_obj) {
+        return 0;
+    }
+    
+    /* The length of a chunk header event is the chunk size */
+    LLHTTP_TRACE(parser_obj, LLHTTP_TRACE_CHUNK_HEADER, NULL, parser->content_length);
+    
+    /* The terminating zero-length chunk is not a data chunk */
+    if (parser->content_length > 0) {
+        /* body_length counts de-chunked bytes as sent, so offsets stay wire positions when decoding */
+        array_init_size(&chunk, 3);
+        add_assoc_long(&chunk, "offset", (zend_long)parser_obj->body_length);
+        add_assoc_long(&chunk, "length", (zend_long)parser->content_length);
+        if (parser_obj->chunk_extensions) {
+            ZVAL_ARR(&extensions, parser_obj->chunk_extensions);
+            parser_obj->chunk_extensions = NULL;
+        } else {
+            ZVAL_EMPTY_ARRAY(&extensions);
+        }
+        add_assoc_zval(&chunk, "extensions", &extensions);
+        zend_hash_next_index_insert(parser_obj->chunks, &chunk);
+    }
+    
+    llhttp_clear_chunk_extensions(parser_obj);
+    
+    return 0;
+}
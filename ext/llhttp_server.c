@@ -0,0 +1,635 @@
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "php_llhttp.h"
+
+#ifdef HAVE_SYS_EPOLL_H
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+/* Native accept/read/parse loop over an epoll set; PHP only sees complete requests */
+
+#define LLHTTP_SERVER_LISTENER_ID 0
+
+static const char llhttp_server_bad_request[] =
+    "HTTP/1.1 400 Bad Request\r\nConnection: close\r\nContent-Length: 0\r\n\r\n";
+
+static void llhttp_server_client_free(llhttp_server_client *client) {
+    close(client->fd);
+    zval_ptr_dtor(&client->parser);
+    if (client->output) {
+        efree(client->output);
+    }
+    efree(client);
+}
+
+static void llhttp_server_client_dtor(zval *zv) {
+    llhttp_server_client_free((llhttp_server_client *)Z_PTR_P(zv));
+}
+
+/* Server object handlers */
+
+zend_object *llhttp_server_object_create(zend_class_entry *ce) {
+    llhttp_server_object *intern = ecalloc(1, sizeof(llhttp_server_object) + zend_object_properties_size(ce));
+
+    zend_object_std_init(&intern->std, ce);
+    object_properties_init(&intern->std, ce);
+
+    intern->listen_fd = -1;
+    intern->epoll_fd = -1;
+    intern->port = 0;
+    intern->next_id = LLHTTP_SERVER_LISTENER_ID + 1;
+    zend_hash_init(&intern->clients, 0, NULL, llhttp_server_client_dtor, 0);
+    ZVAL_UNDEF(&intern->options);
+    ZVAL_UNDEF(&intern->held);
+    intern->buffer = NULL;
+    intern->std.handlers = &llhttp_server_object_handlers;
+
+    return &intern->std;
+}
+
+void llhttp_server_object_free(zend_object *obj) {
+    llhttp_server_object *intern = llhttp_server_object_from_zend_object(obj);
+
+    zend_hash_destroy(&intern->clients);
+    if (intern->epoll_fd >= 0) {
+        close(intern->epoll_fd);
+    }
+    if (intern->listen_fd >= 0) {
+        close(intern->listen_fd);
+    }
+    zval_ptr_dtor(&intern->options);
+    zval_ptr_dtor(&intern->held);
+    if (intern->buffer) {
+        efree(intern->buffer);
+    }
+
+    zend_object_std_dtor(&intern->std);
+}
+
+HashTable *llhttp_server_object_get_gc(zend_object *obj, zval **table, int *n) {
+    llhttp_server_object *intern = llhttp_server_object_from_zend_object(obj);
+    zend_get_gc_buffer *gc_buffer = zend_get_gc_buffer_create();
+    llhttp_server_client *client;
+
+    ZEND_HASH_FOREACH_PTR(&intern->clients, client) {
+        zend_get_gc_buffer_add_zval(gc_buffer, &client->parser);
+    } ZEND_HASH_FOREACH_END();
+    if (Z_TYPE(intern->options) != IS_UNDEF) {
+        zend_get_gc_buffer_add_zval(gc_buffer, &intern->options);
+    }
+    if (Z_TYPE(intern->held) != IS_UNDEF) {
+        zend_get_gc_buffer_add_zval(gc_buffer, &intern->held);
+    }
+
+    zend_get_gc_buffer_use(gc_buffer, table, n);
+    return zend_std_get_properties(obj);
+}
+
+/* Per-connection parser, built through the Parser constructor so every option applies */
+static zend_result llhttp_server_parser_init(llhttp_server_object *server, zval *parser) {
+    zval type;
+
+    ZVAL_LONG(&type, LLHTTP_TYPE_REQUEST);
+    if (object_init_ex(parser, llhttp_parser_ce) == FAILURE) {
+        return FAILURE;
+    }
+    zend_call_known_instance_method_with_2_params(llhttp_parser_ce->constructor, Z_OBJ_P(parser), NULL, &type, &server->options);
+    if (EG(exception)) {
+        zval_ptr_dtor(parser);
+        ZVAL_UNDEF(parser);
+        return FAILURE;
+    }
+
+    /* Batched offsets would index the shared receive buffer, which PHP never sees */
+    if (llhttp_parser_object_from_zend_object(Z_OBJ_P(parser))->event_mask & LLHTTP_EVENT_BATCH) {
+        zval_ptr_dtor(parser);
+        ZVAL_UNDEF(parser);
+        zend_throw_exception(llhttp_exception_ce, "Parser option \"batchEvents\" is not supported with Server", 0);
+        return FAILURE;
+    }
+
+    llhttp_parser_object_from_zend_object(Z_OBJ_P(parser))->pause_on_complete = 1;
+    return SUCCESS;
+}
+
+static void llhttp_server_client_close(llhttp_server_object *server, llhttp_server_client *client) {
+    /* Closing the descriptor also removes it from the epoll set */
+    zend_hash_index_del(&server->clients, (zend_ulong)client->id);
+}
+
+/* Reads stop once a connection drains; EPOLLOUT is armed only while output remains */
+static void llhttp_server_client_watch(llhttp_server_object *server, llhttp_server_client *client) {
+    struct epoll_event event;
+
+    event.events = (client->draining ? 0 : EPOLLIN) | (client->writable_armed ? EPOLLOUT : 0);
+    event.data.u64 = (uint64_t)client->id;
+    epoll_ctl(server->epoll_fd, EPOLL_CTL_MOD, client->fd, &event);
+}
+
+/* Nothing more is read from a draining connection; it closes once its replies are written */
+static void llhttp_server_client_drain(llhttp_server_object *server, llhttp_server_client *client) {
+    client->draining = 1;
+    llhttp_server_client_watch(server, client);
+}
+
+/* Write as much pending output as the socket takes */
+static void llhttp_server_client_flush(llhttp_server_object *server, llhttp_server_client *client) {
+    while (client->output_sent < client->output_length) {
+        ssize_t n = send(client->fd, client->output + client->output_sent, client->output_length - client->output_sent, MSG_NOSIGNAL);
+
+        if (n > 0) {
+            client->output_sent += (size_t)n;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            break;
+        }
+        llhttp_server_client_close(server, client);
+        return;
+    }
+
+    if (client->output_sent == client->output_length) {
+        client->output_sent = client->output_length = 0;
+        if (client->closing) {
+            llhttp_server_client_close(server, client);
+            return;
+        }
+    }
+
+    if ((client->output_length != 0) != client->writable_armed) {
+        client->writable_armed = client->output_length != 0;
+        llhttp_server_client_watch(server, client);
+    }
+}
+
+static void llhttp_server_client_queue(llhttp_server_client *client, const char *data, size_t length) {
+    if (client->output_length + length > client->output_capacity) {
+        client->output_capacity = MAX(client->output_length + length, client->output_capacity * 2);
+        client->output = erealloc(client->output, client->output_capacity);
+    }
+    memcpy(client->output + client->output_length, data, length);
+    client->output_length += length;
+}
+
+/* A draining connection that owes no more replies gets its held-back 400, then closes once written */
+static void llhttp_server_client_settle(llhttp_server_object *server, llhttp_server_client *client) {
+    if (client->draining && !client->pending) {
+        if (client->rejected) {
+            llhttp_server_client_queue(client, llhttp_server_bad_request, sizeof(llhttp_server_bad_request) - 1);
+            client->rejected = 0;
+        }
+        client->closing = 1;
+    }
+    llhttp_server_client_flush(server, client);
+}
+
+/* Accept every pending connection; the listener is non-blocking */
+static void llhttp_server_accept(llhttp_server_object *server) {
+    for (;;) {
+        struct epoll_event event;
+        llhttp_server_client *client;
+        int fd = accept4(server->listen_fd, NULL, NULL, SOCK_NONBLOCK | SOCK_CLOEXEC);
+
+        if (fd < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            /* EAGAIN ends the batch; other errors (e.g. EMFILE) leave the backlog for the next poll */
+            return;
+        }
+
+        client = ecalloc(1, sizeof(llhttp_server_client));
+        client->fd = fd;
+        client->id = server->next_id++;
+        if (llhttp_server_parser_init(server, &client->parser) == FAILURE) {
+            close(fd);
+            efree(client);
+            return;
+        }
+
+        event.events = EPOLLIN;
+        event.data.u64 = (uint64_t)client->id;
+        if (epoll_ctl(server->epoll_fd, EPOLL_CTL_ADD, fd, &event) < 0) {
+            llhttp_server_client_free(client);
+            continue;
+        }
+
+        zend_hash_index_add_new_ptr(&server->clients, (zend_ulong)client->id, client);
+    }
+}
+
+/* Snapshot the completed message for PHP; its headers table is shared, not copied */
+static void llhttp_server_message(llhttp_server_client *client, llhttp_parser_object *parser_obj, zval *messages) {
+    zval message, headers;
+    char version[8];
+
+    snprintf(version, sizeof(version), "%d.%d", llhttp_get_http_major(&parser_obj->parser), llhttp_get_http_minor(&parser_obj->parser));
+
+    array_init_size(&message, 7);
+    add_assoc_long(&message, "id", client->id);
+    add_assoc_string(&message, "method", llhttp_method_name((llhttp_method_t)llhttp_get_method(&parser_obj->parser)));
+    if (parser_obj->url) {
+        add_assoc_str(&message, "url", zend_string_copy(parser_obj->url));
+    } else {
+        add_assoc_string(&message, "url", "");
+    }
+    add_assoc_string(&message, "version", version);
+    GC_ADDREF(parser_obj->headers);
+    ZVAL_ARR(&headers, parser_obj->headers);
+    add_assoc_zval(&message, "headers", &headers);
+    if (parser_obj->body) {
+        add_assoc_str(&message, "body", zend_string_copy(parser_obj->body));
+    } else {
+        add_assoc_string(&message, "body", "");
+    }
+    add_assoc_bool(&message, "keepAlive", client->keep_alive);
+
+    add_next_index_zval(messages, &message);
+}
+
+/* Parse everything received; pipelined requests each become a message */
+static zend_result llhttp_server_feed(llhttp_server_object *server, llhttp_server_client *client, const char *data, size_t length, zval *messages) {
+    llhttp_parser_object *parser_obj = llhttp_parser_object_from_zend_object(Z_OBJ(client->parser));
+
+    llhttp_parser_begin(parser_obj, length);
+
+    while (length > 0) {
+        llhttp_errno_t err = llhttp_parser_execute(parser_obj, data, length);
+        const char *end;
+
+        if (err == HPE_OK) {
+            return SUCCESS;
+        }
+        if (err != HPE_PAUSED) {
+            if (EG(exception)) {
+                llhttp_server_client_close(server, client);
+                return FAILURE;
+            }
+
+            /* Malformed requests and upgrades both end the connection; a 400 follows the replies
+             * still owed to pipelined requests, so it is never taken for one of them */
+            client->rejected = err != HPE_PAUSED_UPGRADE;
+            llhttp_server_client_drain(server, client);
+            llhttp_server_client_settle(server, client);
+            return SUCCESS;
+        }
+
+        /* Paused at the end of a message */
+        end = llhttp_get_error_pos(&parser_obj->parser);
+        client->keep_alive = llhttp_should_keep_alive(&parser_obj->parser) && !parser_obj->parser.upgrade;
+        parser_obj->state = LLHTTP_STATE_COMPLETE;
+        llhttp_server_message(client, parser_obj, messages);
+        client->pending++;
+
+        llhttp_resume(&parser_obj->parser);
+        llhttp_parser_clear_message(parser_obj);
+
+        /* Nothing may follow a final request; the connection closes after its response */
+        if (!client->keep_alive) {
+            llhttp_server_client_drain(server, client);
+            return SUCCESS;
+        }
+
+        length -= (size_t)(end - data);
+        data = end;
+    }
+
+    return SUCCESS;
+}
+
+/* Read once per readiness event; the epoll set is level-triggered */
+static zend_result llhttp_server_read(llhttp_server_object *server, llhttp_server_client *client, zval *messages) {
+    ssize_t n;
+
+    if (!server->buffer) {
+        server->buffer = emalloc(LLHTTP_SERVER_READ_SIZE);
+    }
+
+    do {
+        n = recv(client->fd, server->buffer, LLHTTP_SERVER_READ_SIZE, 0);
+    } while (n < 0 && errno == EINTR);
+
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return SUCCESS;
+    }
+    /* A half-closed peer still reads: answer what it already asked before closing */
+    if (n == 0 && (client->pending || client->output_length)) {
+        llhttp_server_client_drain(server, client);
+        llhttp_server_client_settle(server, client);
+        return SUCCESS;
+    }
+    if (n <= 0) {
+        llhttp_server_client_close(server, client);
+        return SUCCESS;
+    }
+
+    return llhttp_server_feed(server, client, server->buffer, (size_t)n, messages);
+}
+
+static void llhttp_server_default_limit(zval *options, const char *name, zend_long value) {
+    if (!zend_hash_str_exists(Z_ARRVAL_P(options), name, strlen(name))) {
+        add_assoc_long(options, name, value);
+    }
+}
+
+/* Keep messages already taken off their connections for the next poll(), as a throwing call returns nothing */
+static void llhttp_server_hold(llhttp_server_object *server, zval *messages) {
+    if (zend_hash_num_elements(Z_ARRVAL_P(messages))) {
+        ZVAL_COPY_VALUE(&server->held, messages);
+    } else {
+        zval_ptr_dtor(messages);
+    }
+    ZVAL_UNDEF(messages);
+}
+
+/* Server class methods */
+
+/* __construct(string $host = "127.0.0.1", int $port = 0, array $options = []) */
+PHP_METHOD(LlhttpServer, __construct) {
+    zend_string *host = NULL;
+    zend_long port = 0;
+    HashTable *options = NULL;
+    struct sockaddr_storage address;
+    socklen_t address_length;
+    struct epoll_event event;
+    zval probe;
+    int one = 1;
+
+    ZEND_PARSE_PARAMETERS_START(0, 3)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_STR(host)
+        Z_PARAM_LONG(port)
+        Z_PARAM_ARRAY_HT(options)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_server_object *intern = llhttp_server_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    if (intern->listen_fd >= 0) {
+        zend_throw_exception(llhttp_exception_ce, "Server is already listening", 0);
+        RETURN_THROWS();
+    }
+    if (port < 0 || port > 65535) {
+        zend_throw_exception(llhttp_exception_ce, "Port must be between 0 and 65535", 0);
+        RETURN_THROWS();
+    }
+
+    memset(&address, 0, sizeof(address));
+    if (!host || inet_pton(AF_INET, ZSTR_VAL(host), &((struct sockaddr_in *)&address)->sin_addr) == 1) {
+        struct sockaddr_in *in = (struct sockaddr_in *)&address;
+
+        in->sin_family = AF_INET;
+        in->sin_port = htons((uint16_t)port);
+        if (!host) {
+            in->sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        }
+        address_length = sizeof(struct sockaddr_in);
+    } else if (inet_pton(AF_INET6, ZSTR_VAL(host), &((struct sockaddr_in6 *)&address)->sin6_addr) == 1) {
+        struct sockaddr_in6 *in6 = (struct sockaddr_in6 *)&address;
+
+        in6->sin6_family = AF_INET6;
+        in6->sin6_port = htons((uint16_t)port);
+        address_length = sizeof(struct sockaddr_in6);
+    } else {
+        zend_throw_exception_ex(llhttp_exception_ce, 0, "Invalid listen address \"%s\"", ZSTR_VAL(host));
+        RETURN_THROWS();
+    }
+
+    /* Options are validated once here; each connection gets a Parser built with them */
+    if (options) {
+        ZVAL_ARR(&intern->options, zend_array_dup(options));
+    } else {
+        array_init(&intern->options);
+    }
+    /* Peers are untrusted, so unlike a bare Parser the limits default to finite values */
+    llhttp_server_default_limit(&intern->options, "maxHeaderBytes", LLHTTP_SERVER_MAX_HEADER_BYTES);
+    llhttp_server_default_limit(&intern->options, "maxHeaders", LLHTTP_SERVER_MAX_HEADERS);
+    llhttp_server_default_limit(&intern->options, "maxUrlLength", LLHTTP_SERVER_MAX_URL_LENGTH);
+    llhttp_server_default_limit(&intern->options, "maxBodySize", LLHTTP_SERVER_MAX_BODY_SIZE);
+    if (llhttp_server_parser_init(intern, &probe) == FAILURE) {
+        RETURN_THROWS();
+    }
+    zval_ptr_dtor(&probe);
+
+    intern->listen_fd = socket(address.ss_family, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (intern->listen_fd < 0) {
+        zend_throw_exception_ex(llhttp_exception_ce, errno, "Cannot create socket: %s", strerror(errno));
+        RETURN_THROWS();
+    }
+    setsockopt(intern->listen_fd, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+
+    if (bind(intern->listen_fd, (struct sockaddr *)&address, address_length) < 0 ||
+        listen(intern->listen_fd, SOMAXCONN) < 0) {
+        zend_throw_exception_ex(llhttp_exception_ce, errno, "Cannot listen on port %d: %s", (int)port, strerror(errno));
+        RETURN_THROWS();
+    }
+
+    /* Port 0 picks a free port; remember which */
+    if (getsockname(intern->listen_fd, (struct sockaddr *)&address, &address_length) == 0) {
+        intern->port = ntohs(address.ss_family == AF_INET6
+            ? ((struct sockaddr_in6 *)&address)->sin6_port
+            : ((struct sockaddr_in *)&address)->sin_port);
+    }
+
+    intern->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    if (intern->epoll_fd < 0) {
+        zend_throw_exception_ex(llhttp_exception_ce, errno, "Cannot create epoll set: %s", strerror(errno));
+        RETURN_THROWS();
+    }
+
+    event.events = EPOLLIN;
+    event.data.u64 = LLHTTP_SERVER_LISTENER_ID;
+    if (epoll_ctl(intern->epoll_fd, EPOLL_CTL_ADD, intern->listen_fd, &event) < 0) {
+        zend_throw_exception_ex(llhttp_exception_ce, errno, "Cannot watch listener: %s", strerror(errno));
+        RETURN_THROWS();
+    }
+}
+
+/* poll(int $timeoutMs = -1): array */
+PHP_METHOD(LlhttpServer, poll) {
+    zend_long timeout = -1;
+    struct epoll_event events[LLHTTP_SERVER_EVENTS];
+    int count;
+
+    ZEND_PARSE_PARAMETERS_START(0, 1)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_LONG(timeout)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_server_object *intern = llhttp_server_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    if (intern->epoll_fd < 0) {
+        zend_throw_exception(llhttp_exception_ce, "Server is not listening", 0);
+        RETURN_THROWS();
+    }
+
+    /* Messages kept back when an earlier poll() threw are returned first, without waiting */
+    if (Z_TYPE(intern->held) == IS_ARRAY) {
+        ZVAL_COPY_VALUE(return_value, &intern->held);
+        ZVAL_UNDEF(&intern->held);
+        timeout = 0;
+    } else {
+        array_init(return_value);
+    }
+
+    count = epoll_wait(intern->epoll_fd, events, LLHTTP_SERVER_EVENTS, timeout < 0 ? -1 : (int)MIN(timeout, INT_MAX));
+    if (count < 0) {
+        if (errno == EINTR) {
+            return;
+        }
+        zend_throw_exception_ex(llhttp_exception_ce, errno, "Poll failed: %s", strerror(errno));
+        llhttp_server_hold(intern, return_value);
+        RETURN_THROWS();
+    }
+
+    for (int i = 0; i < count; i++) {
+        zend_long id = (zend_long)events[i].data.u64;
+        llhttp_server_client *client;
+
+        if (id == LLHTTP_SERVER_LISTENER_ID) {
+            llhttp_server_accept(intern);
+            continue;
+        }
+
+        /* An earlier event in this batch may have closed it */
+        client = zend_hash_index_find_ptr(&intern->clients, (zend_ulong)id);
+        if (!client) {
+            continue;
+        }
+
+        if (events[i].events & EPOLLOUT) {
+            llhttp_server_client_flush(intern, client);
+            client = zend_hash_index_find_ptr(&intern->clients, (zend_ulong)id);
+            if (!client) {
+                continue;
+            }
+        }
+        if (events[i].events & EPOLLIN) {
+            /* Only the throwing client was closed; the rest of the batch is reported again next time */
+            if (llhttp_server_read(intern, client, return_value) == FAILURE) {
+                llhttp_server_hold(intern, return_value);
+                RETURN_THROWS();
+            }
+        } else if (events[i].events & (EPOLLHUP | EPOLLERR)) {
+            /* A draining connection no longer reads; a reset peer cannot take its reply */
+            llhttp_server_client_close(intern, client);
+        }
+    }
+}
+
+/* send(int $id, string $data, bool $end = true): bool */
+PHP_METHOD(LlhttpServer, send) {
+    zend_long id;
+    zend_string *data;
+    zend_bool end = 1;
+    llhttp_server_client *client;
+
+    ZEND_PARSE_PARAMETERS_START(2, 3)
+        Z_PARAM_LONG(id)
+        Z_PARAM_STR(data)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(end)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_server_object *intern = llhttp_server_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    client = zend_hash_index_find_ptr(&intern->clients, (zend_ulong)id);
+    if (!client || client->closing) {
+        RETURN_FALSE;
+    }
+
+    if (end && client->pending) {
+        client->pending--;
+    }
+
+    llhttp_server_client_queue(client, ZSTR_VAL(data), ZSTR_LEN(data));
+    llhttp_server_client_settle(intern, client);
+
+    RETURN_TRUE;
+}
+
+/* close(int $id): bool */
+PHP_METHOD(LlhttpServer, close) {
+    zend_long id;
+    llhttp_server_client *client;
+
+    ZEND_PARSE_PARAMETERS_START(1, 1)
+        Z_PARAM_LONG(id)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_server_object *intern = llhttp_server_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    client = zend_hash_index_find_ptr(&intern->clients, (zend_ulong)id);
+    if (!client) {
+        RETURN_FALSE;
+    }
+
+    llhttp_server_client_close(intern, client);
+    RETURN_TRUE;
+}
+
+/* getPort(): int */
+PHP_METHOD(LlhttpServer, getPort) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_server_object *intern = llhttp_server_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    RETURN_LONG(intern->port);
+}
+
+/* getConnectionCount(): int */
+PHP_METHOD(LlhttpServer, getConnectionCount) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_server_object *intern = llhttp_server_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    RETURN_LONG(zend_hash_num_elements(&intern->clients));
+}
+
+/* Arginfo for Server */
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_server_construct, 0, 0, 0)
+    ZEND_ARG_TYPE_INFO(0, host, IS_STRING, 0)
+    ZEND_ARG_TYPE_INFO(0, port, IS_LONG, 0)
+    ZEND_ARG_TYPE_INFO(0, options, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_server_poll, 0, 0, 0)
+    ZEND_ARG_TYPE_INFO(0, timeoutMs, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_server_send, 0, 0, 2)
+    ZEND_ARG_TYPE_INFO(0, id, IS_LONG, 0)
+    ZEND_ARG_TYPE_INFO(0, data, IS_STRING, 0)
+    ZEND_ARG_TYPE_INFO(0, end, _IS_BOOL, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_server_close, 0, 0, 1)
+    ZEND_ARG_TYPE_INFO(0, id, IS_LONG, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_server_getPort, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_server_getConnectionCount, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+/* Method entries for Server class */
+const zend_function_entry llhttp_server_methods[] = {
+    PHP_ME(LlhttpServer, __construct,       arginfo_llhttp_server_construct, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpServer, poll,              arginfo_llhttp_server_poll, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpServer, send,              arginfo_llhttp_server_send, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpServer, close,             arginfo_llhttp_server_close, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpServer, getPort,           arginfo_llhttp_server_getPort, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpServer, getConnectionCount, arginfo_llhttp_server_getConnectionCount, ZEND_ACC_PUBLIC)
+    PHP_FE_END
+};
+
+#endif /* HAVE_SYS_EPOLL_H */
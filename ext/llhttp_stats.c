@@ -0,0 +1,223 @@
+#include "php_llhttp.h"
+#include "ext/standard/info.h"
+
+ZEND_EXTERN_MODULE_GLOBALS(llhttp)
+
+/* Module-wide counters; module globals are per thread under ZTS, so no locking */
+
+static const char *llhttp_stats_header_bucket_names[LLHTTP_STATS_HEADER_BUCKETS] = {
+    "0-7", "8-15", "16-31", "32-63", "64-127", "128+"
+};
+
+/* Log2 bucket for a message's header count */
+void llhttp_stats_headers(uint32_t count) {
+    uint32_t bucket = 0;
+
+    while (count >= 8 && bucket < LLHTTP_STATS_HEADER_BUCKETS - 1) {
+        count >>= 1;
+        bucket++;
+    }
+    LLHTTP_G(stats).header_histogram[bucket]++;
+}
+
+void llhttp_stats_error(int err) {
+    if (err > 0 && err < LLHTTP_STATS_ERROR_CODES) {
+        LLHTTP_G(stats).errors[err]++;
+    }
+}
+
+static zend_long llhttp_stats_total_errors(void) {
+    uint64_t total = 0;
+
+    for (int i = 0; i < LLHTTP_STATS_ERROR_CODES; i++) {
+        total += LLHTTP_G(stats).errors[i];
+    }
+    return (zend_long)total;
+}
+
+static void llhttp_stats_info_row(const char *name, uint64_t value) {
+    char buf[32];
+
+    snprintf(buf, sizeof(buf), "%llu", (unsigned long long)value);
+    php_info_print_table_row(2, name, buf);
+}
+
+static uint32_t llhttp_latency_bucket(uint64_t ns) {
+    uint32_t exponent;
+
+    if (ns < LLHTTP_LATENCY_SUB_BUCKETS) {
+        return (uint32_t)ns;
+    }
+
+#if defined(__GNUC__)
+    exponent = 63 - (uint32_t)__builtin_clzll(ns);
+#else
+    for (exponent = 4; exponent < 63 && (ns >> (exponent + 1)); exponent++);
+#endif
+    if (exponent >= 40) {
+        return LLHTTP_LATENCY_BUCKETS - 1;
+    }
+
+    /* The top four bits below the leading one pick the sub-bucket */
+    return (exponent - 3) * LLHTTP_LATENCY_SUB_BUCKETS + (uint32_t)((ns >> (exponent - 4)) & (LLHTTP_LATENCY_SUB_BUCKETS - 1));
+}
+
+/* Highest value that lands in a bucket, so percentiles never under-report */
+static uint64_t llhttp_latency_bucket_value(uint32_t bucket) {
+    uint32_t exponent, sub;
+
+    if (bucket < LLHTTP_LATENCY_SUB_BUCKETS) {
+        return bucket;
+    }
+
+    exponent = bucket / LLHTTP_LATENCY_SUB_BUCKETS + 3;
+    sub = bucket % LLHTTP_LATENCY_SUB_BUCKETS;
+    return ((uint64_t)(LLHTTP_LATENCY_SUB_BUCKETS + sub + 1) << (exponent - 4)) - 1;
+}
+
+void llhttp_latency_record(int type, uint64_t ns) {
+    llhttp_latency_histogram *histogram;
+
+    if (type != HTTP_REQUEST && type != HTTP_RESPONSE) {
+        return;
+    }
+
+    histogram = &LLHTTP_G(latency)[type == HTTP_RESPONSE];
+    histogram->buckets[llhttp_latency_bucket(ns)]++;
+    histogram->count++;
+    if (ns > histogram->max) {
+        histogram->max = ns;
+    }
+}
+
+/* Value at quantile q (in thousandths), capped at the observed maximum */
+static uint64_t llhttp_latency_quantile(const llhttp_latency_histogram *histogram, uint32_t q) {
+    uint64_t target = (histogram->count * q + 999) / 1000, seen = 0;
+
+    if (histogram->count == 0) {
+        return 0;
+    }
+
+    for (uint32_t i = 0; i < LLHTTP_LATENCY_BUCKETS; i++) {
+        seen += histogram->buckets[i];
+        if (seen >= target) {
+            return MIN(llhttp_latency_bucket_value(i), histogram->max);
+        }
+    }
+    return histogram->max;
+}
+
+static void llhttp_latency_summary(zval *dest, const llhttp_latency_histogram *histogram) {
+    array_init_size(dest, 5);
+    add_assoc_long(dest, "count", (zend_long)histogram->count);
+    add_assoc_long(dest, "p50", (zend_long)llhttp_latency_quantile(histogram, 500));
+    add_assoc_long(dest, "p99", (zend_long)llhttp_latency_quantile(histogram, 990));
+    add_assoc_long(dest, "p999", (zend_long)llhttp_latency_quantile(histogram, 999));
+    add_assoc_long(dest, "max", (zend_long)histogram->max);
+}
+
+static void llhttp_latency_info_row(const char *name, const llhttp_latency_histogram *histogram) {
+    char buf[96];
+
+    snprintf(buf, sizeof(buf), "p50 %llu ns, p99 %llu ns, p999 %llu ns",
+        (unsigned long long)llhttp_latency_quantile(histogram, 500),
+        (unsigned long long)llhttp_latency_quantile(histogram, 990),
+        (unsigned long long)llhttp_latency_quantile(histogram, 999));
+    php_info_print_table_row(2, name, buf);
+}
+
+/* Rows for phpinfo() */
+void llhttp_stats_info(void) {
+    const llhttp_stats *stats = &LLHTTP_G(stats);
+
+    llhttp_stats_info_row("Messages parsed", stats->messages);
+    llhttp_stats_info_row("Bytes parsed", stats->bytes);
+    llhttp_stats_info_row("Body bytes", stats->body_bytes);
+    llhttp_stats_info_row("Parse errors", (uint64_t)llhttp_stats_total_errors());
+    llhttp_stats_info_row("Buffer reallocations", stats->reallocations);
+    llhttp_stats_info_row("Head cache hits", stats->head_cache_hits);
+    llhttp_stats_info_row("Head cache misses", stats->head_cache_misses);
+    llhttp_stats_info_row("Negotiation cache hits", stats->negotiate_cache_hits);
+    llhttp_stats_info_row("Negotiation cache misses", stats->negotiate_cache_misses);
+
+    if (LLHTTP_G(latency_histogram)) {
+        llhttp_latency_info_row("Request parse latency", &LLHTTP_G(latency)[0]);
+        llhttp_latency_info_row("Response parse latency", &LLHTTP_G(latency)[1]);
+    }
+}
+
+/* Stats::get(): array */
+PHP_METHOD(LlhttpStats, get) {
+    const llhttp_stats *stats;
+    zval errors, headers;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    stats = &LLHTTP_G(stats);
+
+    /* Keyed by error name, only codes that occurred */
+    array_init(&errors);
+    for (int i = 1; i < LLHTTP_STATS_ERROR_CODES; i++) {
+        if (stats->errors[i]) {
+            add_assoc_long(&errors, llhttp_errno_name((llhttp_errno_t)i), (zend_long)stats->errors[i]);
+        }
+    }
+
+    array_init_size(&headers, LLHTTP_STATS_HEADER_BUCKETS);
+    for (int i = 0; i < LLHTTP_STATS_HEADER_BUCKETS; i++) {
+        add_assoc_long(&headers, llhttp_stats_header_bucket_names[i], (zend_long)stats->header_histogram[i]);
+    }
+
+    array_init_size(return_value, 12);
+    add_assoc_long(return_value, "messages", (zend_long)stats->messages);
+    add_assoc_long(return_value, "bytes", (zend_long)stats->bytes);
+    add_assoc_long(return_value, "bodyBytes", (zend_long)stats->body_bytes);
+    add_assoc_long(return_value, "errorCount", llhttp_stats_total_errors());
+    add_assoc_zval(return_value, "errors", &errors);
+    add_assoc_zval(return_value, "headerCounts", &headers);
+    add_assoc_long(return_value, "reallocations", (zend_long)stats->reallocations);
+    add_assoc_long(return_value, "headCacheHits", (zend_long)stats->head_cache_hits);
+    add_assoc_long(return_value, "headCacheMisses", (zend_long)stats->head_cache_misses);
+    add_assoc_long(return_value, "negotiateCacheHits", (zend_long)stats->negotiate_cache_hits);
+    add_assoc_long(return_value, "negotiateCacheMisses", (zend_long)stats->negotiate_cache_misses);
+}
+
+/* Stats::reset(): void */
+PHP_METHOD(LlhttpStats, reset) {
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    memset(&LLHTTP_G(stats), 0, sizeof(llhttp_stats));
+    memset(LLHTTP_G(latency), 0, sizeof(LLHTTP_G(latency)));
+}
+
+/* Stats::latency(): array */
+PHP_METHOD(LlhttpStats, latency) {
+    zval summary;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    array_init_size(return_value, 3);
+    add_assoc_bool(return_value, "enabled", LLHTTP_G(latency_histogram));
+    llhttp_latency_summary(&summary, &LLHTTP_G(latency)[0]);
+    add_assoc_zval(return_value, "request", &summary);
+    llhttp_latency_summary(&summary, &LLHTTP_G(latency)[1]);
+    add_assoc_zval(return_value, "response", &summary);
+}
+
+/* Arginfo for Stats */
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_stats_get, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_stats_reset, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_stats_latency, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+/* Method entries for Stats class */
+const zend_function_entry llhttp_stats_methods[] = {
+    PHP_ME(LlhttpStats, get,     arginfo_llhttp_stats_get, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+    PHP_ME(LlhttpStats, reset,   arginfo_llhttp_stats_reset, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+    PHP_ME(LlhttpStats, latency, arginfo_llhttp_stats_latency, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+    PHP_FE_END
+};
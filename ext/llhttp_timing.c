@@ -0,0 +1,70 @@
+#include "php_llhttp.h"
+
+#if PHP_VERSION_ID >= 80300
+# include "zend_hrtime.h"
+#elif defined(PHP_WIN32)
+# include <windows.h>
+#else
+# include <time.h>
+#endif
+
+/* Monotonic nanoseconds on the same clock as hrtime(true) */
+uint64_t llhttp_monotonic_ns(void) {
+#if PHP_VERSION_ID >= 80300
+    return zend_hrtime();
+#elif defined(PHP_WIN32)
+    static LARGE_INTEGER frequency;
+    LARGE_INTEGER counter;
+
+    if (!frequency.QuadPart) {
+        QueryPerformanceFrequency(&frequency);
+    }
+    QueryPerformanceCounter(&counter);
+    return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+#else
+    return 0;
+#endif
+}
+
+static void llhttp_timing_add(zval *timing, const char *key, size_t key_len, uint64_t ns) {
+    if (ns) {
+        add_assoc_long_ex(timing, key, key_len, (zend_long)ns);
+    } else {
+        add_assoc_null_ex(timing, key, key_len);
+    }
+}
+
+/* getTiming(): array */
+PHP_METHOD(LlhttpParser, getTiming) {
+    const char *phase;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    if (!intern->timing_first_byte) {
+        phase = "idle";
+    } else if (!intern->timing_headers_complete) {
+        phase = "headers";
+    } else if (!intern->timing_message_complete) {
+        phase = "body";
+    } else {
+        phase = "complete";
+    }
+
+    array_init_size(return_value, 8);
+    add_assoc_string(return_value, "phase", (char *)phase);
+    llhttp_timing_add(return_value, ZEND_STRL("firstByteAt"), intern->timing_first_byte);
+    llhttp_timing_add(return_value, ZEND_STRL("headersCompleteAt"), intern->timing_headers_complete);
+    llhttp_timing_add(return_value, ZEND_STRL("messageCompleteAt"), intern->timing_message_complete);
+    llhttp_timing_add(return_value, ZEND_STRL("lastProgressAt"), intern->timing_last_progress);
+    /* Token bytes only; whitespace and line breaks show up in totalBytes and lastProgressAt */
+    add_assoc_long(return_value, "headerDataBytes", (zend_long)(intern->message_url_length + intern->message_header_bytes));
+    add_assoc_long(return_value, "bodyBytes", (zend_long)intern->message_body_bytes);
+    add_assoc_long(return_value, "totalBytes", (zend_long)intern->total_bytes);
+}
@@ -0,0 +1,66 @@
+#include "php_llhttp.h"
+
+/* Fixed-size ring of recent callback events (opt-in via the "trace" option) */
+
+static const char *llhttp_trace_event_names[] = {
+    "message_begin",
+    "url",
+    "status",
+    "header_field",
+    "header_value",
+    "header_complete",
+    "headers_complete",
+    "body",
+    "message_complete",
+    "chunk_header",
+    "chunk_extension_name",
+    "chunk_extension_value",
+    "error"
+};
+
+void llhttp_trace_record(llhttp_parser_object *intern, uint8_t event, const char *at, size_t length, uint8_t code) {
+    llhttp_trace_entry *entry = &intern->trace[intern->trace_next++ % intern->trace_size];
+
+    /* Spans are located by stream offset; events without data have none */
+    entry->offset = (at && intern->parse_base) ? intern->parse_offset + (uint64_t)(at - intern->parse_base) : UINT64_MAX;
+    entry->length = (uint32_t)MIN(length, UINT32_MAX);
+    entry->flags = intern->parser.flags;
+    entry->event = event;
+    entry->code = code;
+}
+
+/* getTrace(): array */
+PHP_METHOD(LlhttpParser, getTrace) {
+    uint64_t first, i;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    if (!intern->trace_size) {
+        RETURN_EMPTY_ARRAY();
+    }
+
+    first = intern->trace_next > intern->trace_size ? intern->trace_next - intern->trace_size : 0;
+    array_init_size(return_value, (uint32_t)(intern->trace_next - first));
+
+    /* Oldest first */
+    for (i = first; i < intern->trace_next; i++) {
+        const llhttp_trace_entry *entry = &intern->trace[i % intern->trace_size];
+        zval record;
+
+        array_init_size(&record, 5);
+        add_assoc_string(&record, "event", (char *)llhttp_trace_event_names[entry->event]);
+        if (entry->offset == UINT64_MAX) {
+            add_assoc_null(&record, "offset");
+        } else {
+            add_assoc_long(&record, "offset", (zend_long)entry->offset);
+        }
+        add_assoc_long(&record, "length", (zend_long)entry->length);
+        add_assoc_long(&record, "flags", (zend_long)entry->flags);
+        if (entry->event == LLHTTP_TRACE_ERROR) {
+            add_assoc_long(&record, "code", (zend_long)entry->code);
+        }
+        add_next_index_zval(return_value, &record);
+    }
+}
@@ -0,0 +1,326 @@
+#include "php_llhttp.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+/* Request-target splitting (RFC 9112 section 3.2) */
+
+static zend_always_inline zend_bool llhttp_url_is_scheme_char(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+           c == '+' || c == '-' || c == '.';
+}
+
+static void llhttp_url_span_set(llhttp_url_span *span, size_t offset, size_t length) {
+    span->present = 1;
+    span->offset = offset;
+    span->length = length;
+}
+
+/* Split authority [userinfo@]host[:port] found at url[start, end) */
+static void llhttp_url_split_authority(const char *url, size_t start, size_t end, llhttp_url_parts *parts) {
+    size_t host_start = start;
+    size_t host_end = end;
+    size_t i;
+
+    /* userinfo ends at the last '@' */
+    for (i = end; i > start; i--) {
+        if (url[i - 1] == '@') {
+            llhttp_url_span_set(&parts->userinfo, start, i - 1 - start);
+            host_start = i;
+            break;
+        }
+    }
+
+    /* Port follows the last ':' outside an IPv6 literal */
+    for (i = end; i > host_start; i--) {
+        char c = url[i - 1];
+        if (c == ']') {
+            break;
+        }
+        if (c == ':') {
+            llhttp_url_span_set(&parts->port, i, end - i);
+            host_end = i - 1;
+            break;
+        }
+    }
+
+    llhttp_url_span_set(&parts->host, host_start, host_end - host_start);
+}
+
+/* Split path, query and fragment starting at url[start] */
+static void llhttp_url_split_path(const char *url, size_t start, size_t len, llhttp_url_parts *parts) {
+    size_t i = start;
+    size_t query_start = 0;
+
+    while (i < len && url[i] != '?' && url[i] != '#') {
+        i++;
+    }
+    llhttp_url_span_set(&parts->path, start, i - start);
+
+    if (i < len && url[i] == '?') {
+        query_start = ++i;
+        while (i < len && url[i] != '#') {
+            i++;
+        }
+        llhttp_url_span_set(&parts->query, query_start, i - query_start);
+    }
+
+    if (i < len && url[i] == '#') {
+        i++;
+        llhttp_url_span_set(&parts->fragment, i, len - i);
+    }
+}
+
+void llhttp_url_split(const char *url, size_t len, llhttp_url_parts *parts) {
+    size_t i;
+
+    memset(parts, 0, sizeof(*parts));
+
+    if (len == 1 && url[0] == '*') {
+        parts->form = LLHTTP_URL_FORM_ASTERISK;
+        llhttp_url_span_set(&parts->path, 0, 1);
+        return;
+    }
+
+    if (len == 0 || url[0] == '/') {
+        parts->form = LLHTTP_URL_FORM_ORIGIN;
+        llhttp_url_split_path(url, 0, len, parts);
+        return;
+    }
+
+    /* scheme "://" marks absolute-form; anything else is authority-form (CONNECT) */
+    for (i = 0; i < len && llhttp_url_is_scheme_char(url[i]); i++);
+
+    if (i > 0 && i + 2 < len && url[i] == ':' && url[i + 1] == '/' && url[i + 2] == '/') {
+        size_t authority_start = i + 3;
+        size_t authority_end = authority_start;
+
+        parts->form = LLHTTP_URL_FORM_ABSOLUTE;
+        llhttp_url_span_set(&parts->scheme, 0, i);
+
+        while (authority_end < len && url[authority_end] != '/' && url[authority_end] != '?' && url[authority_end] != '#') {
+            authority_end++;
+        }
+        llhttp_url_split_authority(url, authority_start, authority_end, parts);
+        llhttp_url_split_path(url, authority_end, len, parts);
+        return;
+    }
+
+    parts->form = LLHTTP_URL_FORM_AUTHORITY;
+    llhttp_url_split_authority(url, 0, len, parts);
+}
+
+/* Percent/plus decoding (application/x-www-form-urlencoded) */
+
+/* First '%' or '+' in [p, end), or end when the span needs no decoding */
+const char *llhttp_urlencoded_find_escape(const char *p, const char *end) {
+#ifdef __SSE2__
+    const __m128i percent = _mm_set1_epi8('%');
+    const __m128i plus = _mm_set1_epi8('+');
+
+    while (end - p >= 16) {
+        __m128i block = _mm_loadu_si128((const __m128i *)p);
+        int mask = _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(block, percent), _mm_cmpeq_epi8(block, plus)));
+        if (mask) {
+            return p + __builtin_ctz(mask);
+        }
+        p += 16;
+    }
+#endif
+    while (p < end && *p != '%' && *p != '+') {
+        p++;
+    }
+    return p;
+}
+
+static zend_always_inline int llhttp_hex_value(unsigned char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/* Decode src into dst (at least len bytes), returns the decoded length */
+size_t llhttp_urldecode_into(char *dst, const char *src, size_t len) {
+    const char *end = src + len;
+    char *out = dst;
+
+    while (src < end) {
+        const char *escape = llhttp_urlencoded_find_escape(src, end);
+
+        memcpy(out, src, escape - src);
+        out += escape - src;
+        src = escape;
+        if (src == end) {
+            break;
+        }
+
+        if (*src == '+') {
+            *out++ = ' ';
+            src++;
+        } else if (end - src >= 3 && llhttp_hex_value(src[1]) >= 0 && llhttp_hex_value(src[2]) >= 0) {
+            *out++ = (char)((llhttp_hex_value(src[1]) << 4) | llhttp_hex_value(src[2]));
+            src += 3;
+        } else {
+            /* Malformed escapes are kept literally */
+            *out++ = *src++;
+        }
+    }
+
+    return out - dst;
+}
+
+zend_string *llhttp_urldecode(const char *src, size_t len) {
+    const char *escape = llhttp_urlencoded_find_escape(src, src + len);
+    zend_string *result;
+
+    /* Nothing to decode: a plain copy, or a shared interned string */
+    if (escape == src + len) {
+        if (len <= 1) {
+            return len ? ZSTR_CHAR((zend_uchar)src[0]) : ZSTR_EMPTY_ALLOC();
+        }
+        return zend_string_init(src, len, 0);
+    }
+
+    result = zend_string_alloc(len, 0);
+    ZSTR_LEN(result) = llhttp_urldecode_into(ZSTR_VAL(result), src, len);
+    ZSTR_VAL(result)[ZSTR_LEN(result)] = '\0';
+
+    return result;
+}
+
+/* Decode one "name=value" pair into dest; pairs with an empty name are skipped */
+void llhttp_urlencoded_add_pair(HashTable *dest, const char *pair, size_t len) {
+    const char *eq = memchr(pair, '=', len);
+    size_t name_len = eq ? (size_t)(eq - pair) : len;
+    zend_string *name;
+    zval value;
+
+    if (name_len == 0) {
+        return;
+    }
+
+    name = llhttp_urldecode(pair, name_len);
+    if (eq) {
+        ZVAL_STR(&value, llhttp_urldecode(eq + 1, len - name_len - 1));
+    } else {
+        ZVAL_EMPTY_STRING(&value);
+    }
+
+    /* Last value wins, as with parse_str() for names without brackets */
+    zend_symtable_update(dest, name, &value);
+    zend_string_release(name);
+}
+
+void llhttp_urlencoded_parse(HashTable *dest, const char *src, size_t len) {
+    const char *end = src + len;
+
+    while (src < end) {
+        const char *amp = memchr(src, '&', end - src);
+        const char *pair_end = amp ? amp : end;
+
+        llhttp_urlencoded_add_pair(dest, src, pair_end - src);
+        src = pair_end + 1;
+    }
+}
+
+/* Substring of the URL; empty, one-byte and whole-URL components avoid a copy, others are copied */
+static zend_string *llhttp_url_span_string(zend_string *url, const llhttp_url_span *span) {
+    if (span->length == 0) {
+        return ZSTR_EMPTY_ALLOC();
+    }
+    if (span->length == 1) {
+        return ZSTR_CHAR((zend_uchar)ZSTR_VAL(url)[span->offset]);
+    }
+    if (span->length == ZSTR_LEN(url)) {
+        return zend_string_copy(url);
+    }
+    return zend_string_init(ZSTR_VAL(url) + span->offset, span->length, 0);
+}
+
+/* A component as a string, or as an [offset, length] pair into getUrl() */
+static void llhttp_url_add_span(zval *arr, const char *key, size_t key_len, zend_string *url, const llhttp_url_span *span, zend_bool offsets) {
+    if (span->present && offsets) {
+        zval pair;
+
+        array_init_size(&pair, 2);
+        add_next_index_long(&pair, (zend_long)span->offset);
+        add_next_index_long(&pair, (zend_long)span->length);
+        add_assoc_zval_ex(arr, key, key_len, &pair);
+    } else if (span->present) {
+        add_assoc_str_ex(arr, key, key_len, llhttp_url_span_string(url, span));
+    } else {
+        add_assoc_null_ex(arr, key, key_len);
+    }
+}
+
+/* getUrlParts(bool $offsets = false): array */
+PHP_METHOD(LlhttpParser, getUrlParts) {
+    static const char *forms[] = { "origin", "absolute", "authority", "asterisk" };
+    llhttp_url_parts parts;
+    zend_string *url;
+    zend_bool offsets = 0;
+
+    ZEND_PARSE_PARAMETERS_START(0, 1)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_BOOL(offsets)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    url = intern->url ? intern->url : ZSTR_EMPTY_ALLOC();
+
+    llhttp_url_split(ZSTR_VAL(url), ZSTR_LEN(url), &parts);
+
+    array_init_size(return_value, 8);
+    add_assoc_string(return_value, "form", forms[parts.form]);
+    llhttp_url_add_span(return_value, ZEND_STRL("scheme"), url, &parts.scheme, offsets);
+    llhttp_url_add_span(return_value, ZEND_STRL("userinfo"), url, &parts.userinfo, offsets);
+    llhttp_url_add_span(return_value, ZEND_STRL("host"), url, &parts.host, offsets);
+
+    /* Port is numeric when valid, null otherwise */
+    if (parts.port.present && parts.port.length > 0 && parts.port.length <= 5) {
+        zend_long port = 0;
+        size_t i;
+
+        for (i = 0; i < parts.port.length; i++) {
+            char c = ZSTR_VAL(url)[parts.port.offset + i];
+            if (c < '0' || c > '9') {
+                break;
+            }
+            port = port * 10 + (c - '0');
+        }
+        if (i == parts.port.length && port <= 65535) {
+            add_assoc_long(return_value, "port", port);
+        } else {
+            add_assoc_null(return_value, "port");
+        }
+    } else {
+        add_assoc_null(return_value, "port");
+    }
+
+    llhttp_url_add_span(return_value, ZEND_STRL("path"), url, &parts.path, offsets);
+    llhttp_url_add_span(return_value, ZEND_STRL("query"), url, &parts.query, offsets);
+    llhttp_url_add_span(return_value, ZEND_STRL("fragment"), url, &parts.fragment, offsets);
+}
+
+/* getQuery(): array */
+PHP_METHOD(LlhttpParser, getQuery) {
+    llhttp_url_parts parts;
+
+    ZEND_PARSE_PARAMETERS_NONE();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+
+    array_init(return_value);
+
+    if (!intern->url) {
+        return;
+    }
+
+    llhttp_url_split(ZSTR_VAL(intern->url), ZSTR_LEN(intern->url), &parts);
+
+    if (parts.query.present) {
+        llhttp_urlencoded_parse(Z_ARRVAL_P(return_value), ZSTR_VAL(intern->url) + parts.query.offset, parts.query.length);
+    }
+}
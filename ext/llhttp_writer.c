@@ -0,0 +1,234 @@
+#include "php_llhttp.h"
+
+/* RequestWriter class methods */
+
+/* Append helper: counts only when buf is NULL */
+#define LLHTTP_WRITE(buf, pos, src, len) do { \
+        if (buf) { \
+            memcpy((buf) + (pos), (src), (len)); \
+        } \
+        (pos) += (len); \
+    } while (0)
+
+#define LLHTTP_WRITE_LITERAL(buf, pos, lit) LLHTTP_WRITE(buf, pos, lit, sizeof(lit) - 1)
+
+/* Header validation shared with ChunkedEncoder trailers */
+zend_bool llhttp_is_valid_header_name(zend_string *name) {
+    return name && ZSTR_LEN(name) > 0 && strpbrk(ZSTR_VAL(name), " \t\r\n:") == NULL;
+}
+
+zend_bool llhttp_is_valid_header_value(zend_string *value) {
+    return memchr(ZSTR_VAL(value), '\r', ZSTR_LEN(value)) == NULL &&
+           memchr(ZSTR_VAL(value), '\n', ZSTR_LEN(value)) == NULL;
+}
+
+#define LLHTTP_NAME_IS(name, len, lit) \
+    ((len) == sizeof(lit) - 1 && zend_binary_strcasecmp((name), (len), (lit), sizeof(lit) - 1) == 0)
+
+static zend_bool llhttp_writer_is_framing_header(const char *name, size_t len) {
+    return LLHTTP_NAME_IS(name, len, "content-length") ||
+           LLHTTP_NAME_IS(name, len, "transfer-encoding");
+}
+
+/* Raw header names keep their casing; rules are keyed lowercase */
+static zend_bool llhttp_writer_has_rule(HashTable *rules, const char *name, size_t len) {
+    char *lower = emalloc(len + 1);
+    zend_bool found;
+
+    zend_str_tolower_copy(lower, name, len);
+    found = zend_hash_str_exists(rules, lower, len);
+
+    efree(lower);
+    return found;
+}
+
+static size_t llhttp_writer_header_line(char *buf, size_t pos, const char *name, size_t name_len, const char *value, size_t value_len) {
+    LLHTTP_WRITE(buf, pos, name, name_len);
+    LLHTTP_WRITE_LITERAL(buf, pos, ": ");
+    LLHTTP_WRITE(buf, pos, value, value_len);
+    LLHTTP_WRITE_LITERAL(buf, pos, "\r\n");
+    return pos;
+}
+
+/* Validate overrides and collect their lowercased names into rules.
+ * Accepted values: string (replace or add), array of strings (one line each), null (remove). */
+static zend_bool llhttp_writer_collect_rules(HashTable *overrides, HashTable *rules) {
+    zend_string *name;
+    zval *value, *item, marker;
+
+    ZVAL_NULL(&marker);
+
+    ZEND_HASH_FOREACH_STR_KEY_VAL(overrides, name, value) {
+        if (!llhttp_is_valid_header_name(name)) {
+            zend_throw_exception(llhttp_exception_ce, "Override keys must be valid header names", 0);
+            return 0;
+        }
+
+        if (Z_TYPE_P(value) == IS_STRING) {
+            if (!llhttp_is_valid_header_value(Z_STR_P(value))) {
+                zend_throw_exception_ex(llhttp_exception_ce, 0, "Override value for \"%s\" contains CR or LF", ZSTR_VAL(name));
+                return 0;
+            }
+        } else if (Z_TYPE_P(value) == IS_ARRAY) {
+            ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(value), item) {
+                if (Z_TYPE_P(item) != IS_STRING || !llhttp_is_valid_header_value(Z_STR_P(item))) {
+                    zend_throw_exception_ex(llhttp_exception_ce, 0, "Override values for \"%s\" must be strings without CR or LF", ZSTR_VAL(name));
+                    return 0;
+                }
+            } ZEND_HASH_FOREACH_END();
+        } else if (Z_TYPE_P(value) != IS_NULL) {
+            zend_throw_exception_ex(llhttp_exception_ce, 0, "Override for \"%s\" must be a string, an array of strings or null", ZSTR_VAL(name));
+            return 0;
+        }
+
+        zend_string *lower_name = zend_string_tolower(name);
+        zend_hash_update(rules, lower_name, &marker);
+        zend_string_release(lower_name);
+    } ZEND_HASH_FOREACH_END();
+
+    return 1;
+}
+
+/* Serialize the parsed request into buf, or only measure it when buf is NULL */
+static size_t llhttp_writer_emit(char *buf, llhttp_parser_object *intern, HashTable *overrides, HashTable *rules) {
+    size_t pos = 0;
+    zend_string *name;
+    zval *value, *item;
+    zend_bool had_framing = 0;
+    size_t body_len = intern->body ? ZSTR_LEN(intern->body) : 0;
+    const char *method = llhttp_method_name((llhttp_method_t)llhttp_get_method(&intern->parser));
+    char version[sizeof(" HTTP/255.255\r\n")];
+    size_t version_len = snprintf(version, sizeof(version), " HTTP/%u.%u\r\n",
+        (unsigned)llhttp_get_http_major(&intern->parser), (unsigned)llhttp_get_http_minor(&intern->parser));
+
+    /* Request line */
+    LLHTTP_WRITE(buf, pos, method, strlen(method));
+    LLHTTP_WRITE_LITERAL(buf, pos, " ");
+    if (intern->url) {
+        LLHTTP_WRITE(buf, pos, ZSTR_VAL(intern->url), ZSTR_LEN(intern->url));
+    }
+    LLHTTP_WRITE(buf, pos, version, version_len);
+
+    /* Headers as sent, repeats included, unless an override touches them; framing is recomputed below */
+    for (uint32_t i = 0; i < intern->raw_header_count; i++) {
+        const llhttp_header_span *span = &intern->raw_headers[i];
+        const char *header = intern->raw_arena + span->name_offset;
+
+        if (llhttp_writer_is_framing_header(header, span->name_length)) {
+            had_framing = 1;
+            continue;
+        }
+        if (rules && llhttp_writer_has_rule(rules, header, span->name_length)) {
+            continue;
+        }
+        /* A decompressed body is sent as the plain payload it now is */
+        if (intern->body_decoded && LLHTTP_NAME_IS(header, span->name_length, "content-encoding")) {
+            continue;
+        }
+        pos = llhttp_writer_header_line(buf, pos, header, span->name_length,
+            intern->raw_arena + span->value_offset, span->value_length);
+    }
+
+    /* Overrides, in the order given */
+    if (overrides) {
+        ZEND_HASH_FOREACH_STR_KEY_VAL(overrides, name, value) {
+            if (Z_TYPE_P(value) == IS_STRING) {
+                pos = llhttp_writer_header_line(buf, pos, ZSTR_VAL(name), ZSTR_LEN(name), Z_STRVAL_P(value), Z_STRLEN_P(value));
+            } else if (Z_TYPE_P(value) == IS_ARRAY) {
+                ZEND_HASH_FOREACH_VAL(Z_ARRVAL_P(value), item) {
+                    pos = llhttp_writer_header_line(buf, pos, ZSTR_VAL(name), ZSTR_LEN(name), Z_STRVAL_P(item), Z_STRLEN_P(item));
+                } ZEND_HASH_FOREACH_END();
+            }
+        } ZEND_HASH_FOREACH_END();
+    }
+
+    /* The collected body is already de-chunked, so frame it with Content-Length */
+    if ((body_len > 0 || had_framing) &&
+        !(rules && (zend_hash_str_exists(rules, "content-length", sizeof("content-length") - 1) ||
+                    zend_hash_str_exists(rules, "transfer-encoding", sizeof("transfer-encoding") - 1)))) {
+        char length[MAX_LENGTH_OF_LONG + 1];
+        size_t length_len = snprintf(length, sizeof(length), "%zu", body_len);
+
+        LLHTTP_WRITE_LITERAL(buf, pos, "content-length: ");
+        LLHTTP_WRITE(buf, pos, length, length_len);
+        LLHTTP_WRITE_LITERAL(buf, pos, "\r\n");
+    }
+
+    LLHTTP_WRITE_LITERAL(buf, pos, "\r\n");
+
+    if (body_len > 0) {
+        LLHTTP_WRITE(buf, pos, ZSTR_VAL(intern->body), body_len);
+    }
+
+    return pos;
+}
+
+/* fromParser(Parser $parser, array $overrides = []): string */
+PHP_METHOD(LlhttpRequestWriter, fromParser) {
+    zval *parser_zv;
+    HashTable *overrides = NULL;
+    HashTable rules;
+    size_t len;
+    zend_string *result;
+
+    ZEND_PARSE_PARAMETERS_START(1, 2)
+        Z_PARAM_OBJECT_OF_CLASS(parser_zv, llhttp_parser_ce)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_ARRAY_HT(overrides)
+    ZEND_PARSE_PARAMETERS_END();
+
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(parser_zv));
+
+    if (llhttp_get_type(&intern->parser) != HTTP_REQUEST) {
+        zend_throw_exception(llhttp_exception_ce, "RequestWriter requires a parser that has parsed a request", 0);
+        RETURN_THROWS();
+    }
+
+    /* A request cut short mid-body would be re-framed as a shorter, well-formed one */
+    if (!intern->message_count || !intern->timing_message_complete) {
+        zend_throw_exception(llhttp_exception_ce, "RequestWriter requires a completely parsed request", 0);
+        RETURN_THROWS();
+    }
+
+    /* Without its body the request would go out with Content-Length: 0 */
+    if (intern->body_streamed) {
+        zend_throw_exception(llhttp_exception_ce, "RequestWriter cannot re-emit a body consumed by parseForm or parseMultipart", 0);
+        RETURN_THROWS();
+    }
+
+    if (overrides && zend_hash_num_elements(overrides) == 0) {
+        overrides = NULL;
+    }
+
+    if (overrides) {
+        zend_hash_init(&rules, zend_hash_num_elements(overrides), NULL, NULL, 0);
+        if (!llhttp_writer_collect_rules(overrides, &rules)) {
+            zend_hash_destroy(&rules);
+            RETURN_THROWS();
+        }
+    }
+
+    /* Measure first so the wire format is written into a single allocation */
+    len = llhttp_writer_emit(NULL, intern, overrides, overrides ? &rules : NULL);
+    result = zend_string_alloc(len, 0);
+    llhttp_writer_emit(ZSTR_VAL(result), intern, overrides, overrides ? &rules : NULL);
+    ZSTR_VAL(result)[len] = '\0';
+
+    if (overrides) {
+        zend_hash_destroy(&rules);
+    }
+
+    RETURN_NEW_STR(result);
+}
+
+/* Arginfo for RequestWriter */
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_request_writer_fromParser, 0, 0, 1)
+    ZEND_ARG_OBJ_INFO(0, parser, Llhttp\\Parser, 0)
+    ZEND_ARG_TYPE_INFO(0, overrides, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
+/* Method entries for RequestWriter class */
+const zend_function_entry llhttp_request_writer_methods[] = {
+    PHP_ME(LlhttpRequestWriter, fromParser, arginfo_llhttp_request_writer_fromParser, ZEND_ACC_PUBLIC | ZEND_ACC_STATIC)
+    PHP_FE_END
+};
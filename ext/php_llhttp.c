@@ -12,18 +12,28 @@
 zend_class_entry *llhttp_parser_ce;
 zend_class_entry *llhttp_error_codes_ce;
 zend_class_entry *llhttp_exception_ce;
+zend_class_entry *llhttp_request_writer_ce;
+zend_class_entry *llhttp_chunked_encoder_ce;
+zend_class_entry *llhttp_stats_ce;
+zend_class_entry *llhttp_events_ce;
+zend_class_entry *llhttp_connection_ce;
+zend_class_entry *llhttp_server_ce;
 
 /* Object handlers */
 zend_object_handlers llhttp_parser_object_handlers;
+zend_object_handlers llhttp_chunked_encoder_object_handlers;
+zend_object_handlers llhttp_connection_object_handlers;
+zend_object_handlers llhttp_server_object_handlers;
 
 /* Globals */
 ZEND_DECLARE_MODULE_GLOBALS(llhttp)
 
-/* Parser object utility functions */
-static inline llhttp_parser_object *llhttp_parser_object_from_zend_object(zend_object *obj) {
-    return (llhttp_parser_object *)((char *)(obj) - XtOffsetOf(llhttp_parser_object, std));
-}
+/* INI settings */
+PHP_INI_BEGIN()
+    STD_PHP_INI_BOOLEAN("llhttp.latency_histogram", "0", PHP_INI_ALL, OnUpdateBool, latency_histogram, zend_llhttp_globals, llhttp_globals)
+PHP_INI_END()
 
+/* Parser object utility functions */
 static zend_object *llhttp_parser_object_create(zend_class_entry *ce) {
     llhttp_parser_object *intern = ecalloc(1, sizeof(llhttp_parser_object) + zend_object_properties_size(ce));
     
@@ -39,10 +49,106 @@ static zend_object *llhttp_parser_object_create(zend_class_entry *ce) {
     ALLOC_HASHTABLE(intern->headers);
     zend_hash_init(intern->headers, 16, NULL, ZVAL_PTR_DTOR, 0);
     
+    /* Initialize trailers hash table */
+    ALLOC_HASHTABLE(intern->trailers);
+    zend_hash_init(intern->trailers, 0, NULL, ZVAL_PTR_DTOR, 0);
+    
     intern->current_header_field = NULL;
     intern->current_header_value = NULL;
+    intern->raw_arena = NULL;
+    intern->raw_arena_used = 0;
+    intern->raw_arena_size = 0;
+    intern->raw_headers = NULL;
+    intern->raw_header_count = 0;
+    intern->raw_header_capacity = 0;
     intern->url = NULL;
     intern->body = NULL;
+    intern->body_length = 0;
+    
+    /* Initialize chunk list */
+    ALLOC_HASHTABLE(intern->chunks);
+    zend_hash_init(intern->chunks, 0, NULL, ZVAL_PTR_DTOR, 0);
+    intern->chunk_extensions = NULL;
+    intern->chunk_ext_name = NULL;
+    intern->chunk_ext_value = NULL;
+    intern->chunk_ext_name_done = 0;
+    
+    /* Body decoding is opt-in */
+    intern->decompress = 0;
+    intern->max_decompressed_size = LLHTTP_DEFAULT_MAX_DECOMPRESSED_SIZE;
+    intern->decoder = NULL;
+    intern->body_decoded = 0;
+    
+    intern->message_flags = 0;
+    intern->message_content_length = 0;
+    intern->message_upgrade = 0;
+    intern->message_count = 0;
+    llhttp_fingerprint_reset(&intern->fingerprint);
+    intern->cache_heads = 0;
+    
+    /* No limits unless configured */
+    intern->max_header_bytes = 0;
+    intern->max_headers = 0;
+    intern->max_url_length = 0;
+    intern->max_body_size = 0;
+    intern->message_header_bytes = 0;
+    intern->message_header_count = 0;
+    intern->message_url_length = 0;
+    intern->message_body_bytes = 0;
+    
+    intern->parse_time = 0;
+    intern->timing_first_byte = 0;
+    intern->timing_headers_complete = 0;
+    intern->timing_message_complete = 0;
+    intern->timing_last_progress = 0;
+    intern->total_bytes = 0;
+    
+    /* Tracing is opt-in */
+    intern->parse_base = NULL;
+    intern->parse_offset = 0;
+    intern->trace = NULL;
+    intern->trace_size = 0;
+    intern->trace_next = 0;
+    
+    /* No event subscriptions */
+    intern->event_mask = 0;
+    for (int i = 0; i < LLHTTP_EVENT_COUNT; i++) {
+        ZVAL_UNDEF(&intern->event_callbacks[i]);
+        intern->event_fcc[i] = empty_fcall_info_cache;
+    }
+    intern->batch = NULL;
+    intern->pause_on_complete = 0;
+    intern->executing = 0;
+    intern->batch_count = 0;
+    intern->batch_capacity = 0;
+    ZVAL_UNDEF(&intern->batch_callback);
+    
+    /* Form decoding is opt-in */
+    intern->parse_form = 0;
+    intern->max_form_fields = LLHTTP_DEFAULT_MAX_FORM_FIELDS;
+    intern->max_form_field_size = LLHTTP_DEFAULT_MAX_FORM_FIELD_SIZE;
+    intern->form_active = 0;
+    ALLOC_HASHTABLE(intern->form);
+    zend_hash_init(intern->form, 0, NULL, ZVAL_PTR_DTOR, 0);
+    intern->form_pending = NULL;
+    intern->form_fields = 0;
+    
+    /* Multipart decoding is opt-in */
+    intern->parse_multipart = 0;
+    ZVAL_UNDEF(&intern->multipart_sink);
+    intern->multipart = NULL;
+    ALLOC_HASHTABLE(intern->parts);
+    zend_hash_init(intern->parts, 0, NULL, ZVAL_PTR_DTOR, 0);
+    intern->body_streamed = 0;
+    
+    /* Cookies are indexed lazily */
+    intern->cookies_indexed = 0;
+    intern->cookie_source = NULL;
+    intern->cookie_spans = NULL;
+    intern->cookie_count = 0;
+    intern->cookie_capacity = 0;
+    ALLOC_HASHTABLE(intern->cookie_values);
+    zend_hash_init(intern->cookie_values, 0, NULL, ZVAL_PTR_DTOR, 0);
     
     intern->std.handlers = &llhttp_parser_object_handlers;
     
@@ -52,10 +158,15 @@ static zend_object *llhttp_parser_object_create(zend_class_entry *ce) {
 static void llhttp_parser_object_free(zend_object *obj) {
     llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(obj);
     
-    /* Free headers hash table */
+    /* Release headers, which may be shared with the head cache or userland */
     if (intern->headers) {
-        zend_hash_destroy(intern->headers);
-        FREE_HASHTABLE(intern->headers);
+        zend_array_release(intern->headers);
+    }
+    
+    /* Free trailers hash table */
+    if (intern->trailers) {
+        zend_hash_destroy(intern->trailers);
+        FREE_HASHTABLE(intern->trailers);
     }
     
     /* Free current header strings */
@@ -66,6 +177,14 @@ static void llhttp_parser_object_free(zend_object *obj) {
         zend_string_release(intern->current_header_value);
     }
     
+    /* Free raw header arena */
+    if (intern->raw_arena) {
+        efree(intern->raw_arena);
+    }
+    if (intern->raw_headers) {
+        efree(intern->raw_headers);
+    }
+    
     /* Free data strings */
     if (intern->url) {
         zend_string_release(intern->url);
@@ -74,17 +193,200 @@ static void llhttp_parser_object_free(zend_object *obj) {
         zend_string_release(intern->body);
     }
     
+    /* Free chunk data */
+    if (intern->chunks) {
+        zend_hash_destroy(intern->chunks);
+        FREE_HASHTABLE(intern->chunks);
+    }
+    llhttp_clear_chunk_extensions(intern);
+    
+    /* Free body decoder */
+    if (intern->decoder) {
+        llhttp_body_decoder_free(intern->decoder);
+    }
+    
+    /* Free form data */
+    if (intern->form) {
+        llhttp_form_clear(intern);
+        zend_hash_destroy(intern->form);
+        FREE_HASHTABLE(intern->form);
+    }
+    
+    /* Free multipart data and remove its temp files */
+    llhttp_multipart_free(intern->multipart);
+    if (intern->parts) {
+        llhttp_multipart_clear_parts(intern);
+        zend_hash_destroy(intern->parts);
+        FREE_HASHTABLE(intern->parts);
+    }
+    zval_ptr_dtor(&intern->multipart_sink);
+    
+    /* Free cookie index */
+    if (intern->cookie_values) {
+        llhttp_cookie_clear(intern);
+        zend_hash_destroy(intern->cookie_values);
+        FREE_HASHTABLE(intern->cookie_values);
+    }
+    if (intern->cookie_spans) {
+        efree(intern->cookie_spans);
+    }
+    
+    /* Free trace ring */
+    if (intern->trace) {
+        efree(intern->trace);
+    }
+    
+    /* Release event callbacks and batch records */
+    llhttp_events_clear(intern);
+    if (intern->batch) {
+        efree(intern->batch);
+    }
+    zval_ptr_dtor(&intern->batch_callback);
+    
     zend_object_std_dtor(obj);
 }
 
+/* Callbacks can reference the parser, so expose them to the cycle collector */
+static HashTable *llhttp_parser_object_get_gc(zend_object *obj, zval **table, int *n) {
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(obj);
+    zend_get_gc_buffer *gc_buffer = zend_get_gc_buffer_create();
+    
+    for (int i = 0; i < LLHTTP_EVENT_COUNT; i++) {
+        if (Z_TYPE(intern->event_callbacks[i]) != IS_UNDEF) {
+            zend_get_gc_buffer_add_zval(gc_buffer, &intern->event_callbacks[i]);
+        }
+    }
+    if (Z_TYPE(intern->multipart_sink) != IS_UNDEF) {
+        zend_get_gc_buffer_add_zval(gc_buffer, &intern->multipart_sink);
+    }
+    if (Z_TYPE(intern->batch_callback) != IS_UNDEF) {
+        zend_get_gc_buffer_add_zval(gc_buffer, &intern->batch_callback);
+    }
+    
+    zend_get_gc_buffer_use(gc_buffer, table, n);
+    return zend_std_get_properties(obj);
+}
+
+/* Constructor option helpers */
+static zend_bool llhttp_parser_option_long(zend_string *name, zval *value, zend_long *dest) {
+    if (Z_TYPE_P(value) != IS_LONG || Z_LVAL_P(value) < 0) {
+        zend_throw_exception_ex(llhttp_exception_ce, 0, "Parser option \"%s\" must be a non-negative integer", ZSTR_VAL(name));
+        return 0;
+    }
+    
+    *dest = Z_LVAL_P(value);
+    return 1;
+}
+
+static zend_bool llhttp_parser_apply_options(llhttp_parser_object *intern, HashTable *options) {
+    zend_string *name;
+    zval *value;
+    
+    ZEND_HASH_FOREACH_STR_KEY_VAL(options, name, value) {
+        if (!name) {
+            zend_throw_exception(llhttp_exception_ce, "Parser options must be keyed by option name", 0);
+            return 0;
+        }
+        
+        if (zend_string_equals_literal(name, "decompress")) {
+            intern->decompress = zend_is_true(value);
+        } else if (zend_string_equals_literal(name, "maxDecompressedSize")) {
+            if (!llhttp_parser_option_long(name, value, &intern->max_decompressed_size)) {
+                return 0;
+            }
+        } else if (zend_string_equals_literal(name, "parseForm")) {
+            intern->parse_form = zend_is_true(value);
+        } else if (zend_string_equals_literal(name, "maxFormFields")) {
+            if (!llhttp_parser_option_long(name, value, &intern->max_form_fields)) {
+                return 0;
+            }
+        } else if (zend_string_equals_literal(name, "maxFormFieldSize")) {
+            if (!llhttp_parser_option_long(name, value, &intern->max_form_field_size)) {
+                return 0;
+            }
+        } else if (zend_string_equals_literal(name, "maxHeaderBytes")) {
+            if (!llhttp_parser_option_long(name, value, &intern->max_header_bytes)) {
+                return 0;
+            }
+        } else if (zend_string_equals_literal(name, "maxHeaders")) {
+            if (!llhttp_parser_option_long(name, value, &intern->max_headers)) {
+                return 0;
+            }
+        } else if (zend_string_equals_literal(name, "maxUrlLength")) {
+            if (!llhttp_parser_option_long(name, value, &intern->max_url_length)) {
+                return 0;
+            }
+        } else if (zend_string_equals_literal(name, "maxBodySize")) {
+            if (!llhttp_parser_option_long(name, value, &intern->max_body_size)) {
+                return 0;
+            }
+        } else if (zend_string_equals_literal(name, "trace")) {
+            zend_long size;
+            
+            if (!llhttp_parser_option_long(name, value, &size)) {
+                return 0;
+            }
+            if (size > LLHTTP_MAX_TRACE_SIZE) {
+                zend_throw_exception_ex(llhttp_exception_ce, 0, "Parser option \"trace\" must not exceed %d", LLHTTP_MAX_TRACE_SIZE);
+                return 0;
+            }
+            if (intern->trace) {
+                efree(intern->trace);
+                intern->trace = NULL;
+            }
+            intern->trace_size = (uint32_t)size;
+            intern->trace_next = 0;
+            if (size) {
+                intern->trace = safe_emalloc(size, sizeof(llhttp_trace_entry), 0);
+            }
+        } else if (zend_string_equals_literal(name, "cacheHeads")) {
+            intern->cache_heads = zend_is_true(value);
+        } else if (zend_string_equals_literal(name, "parseMultipart")) {
+            intern->parse_multipart = zend_is_true(value);
+        } else if (zend_string_equals_literal(name, "multipartSink")) {
+            if (Z_TYPE_P(value) != IS_NULL && !zend_is_callable(value, 0, NULL)) {
+                zend_throw_exception(llhttp_exception_ce, "Parser option \"multipartSink\" must be callable or null", 0);
+                return 0;
+            }
+            zval_ptr_dtor(&intern->multipart_sink);
+            if (Z_TYPE_P(value) == IS_NULL) {
+                ZVAL_UNDEF(&intern->multipart_sink);
+            } else {
+                ZVAL_COPY(&intern->multipart_sink, value);
+            }
+        } else if (zend_string_equals_literal(name, "batchEvents")) {
+            /* true collects for getEvents(); a callable also receives each batch */
+            zval_ptr_dtor(&intern->batch_callback);
+            ZVAL_UNDEF(&intern->batch_callback);
+            if (Z_TYPE_P(value) == IS_TRUE || Z_TYPE_P(value) == IS_FALSE || Z_TYPE_P(value) == IS_NULL) {
+                intern->event_mask = zend_is_true(value) ? (intern->event_mask | LLHTTP_EVENT_BATCH) : (intern->event_mask & ~LLHTTP_EVENT_BATCH);
+            } else if (zend_is_callable(value, 0, NULL)) {
+                ZVAL_COPY(&intern->batch_callback, value);
+                intern->event_mask |= LLHTTP_EVENT_BATCH;
+            } else {
+                zend_throw_exception(llhttp_exception_ce, "Parser option \"batchEvents\" must be a bool or callable", 0);
+                return 0;
+            }
+        } else {
+            zend_throw_exception_ex(llhttp_exception_ce, 0, "Unknown parser option \"%s\"", ZSTR_VAL(name));
+            return 0;
+        }
+    } ZEND_HASH_FOREACH_END();
+    
+    return 1;
+}
+
 /* Parser class methods */
 
-/* __construct(int $type) */
+/* __construct(int $type, array $options = []) */
 PHP_METHOD(LlhttpParser, __construct) {
     zend_long type = LLHTTP_TYPE_REQUEST;
+    HashTable *options = NULL;
     
-    ZEND_PARSE_PARAMETERS_START(1, 1)
+    ZEND_PARSE_PARAMETERS_START(1, 2)
         Z_PARAM_LONG(type)
+        Z_PARAM_OPTIONAL
+        Z_PARAM_ARRAY_HT(options)
     ZEND_PARSE_PARAMETERS_END();
     
     if (type != LLHTTP_TYPE_BOTH && type != LLHTTP_TYPE_REQUEST && type != LLHTTP_TYPE_RESPONSE) {
@@ -95,6 +397,10 @@ PHP_METHOD(LlhttpParser, __construct) {
     llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
     intern->type = (int)type;
     
+    if (options && !llhttp_parser_apply_options(intern, options)) {
+        RETURN_THROWS();
+    }
+    
     /* Initialize llhttp parser */
     llhttp_settings_init(&intern->settings);
     
@@ -104,9 +410,15 @@ PHP_METHOD(LlhttpParser, __construct) {
     intern->settings.on_status = llhttp_on_status_cb;
     intern->settings.on_header_field = llhttp_on_header_field_cb;
     intern->settings.on_header_value = llhttp_on_header_value_cb;
+    intern->settings.on_header_value_complete = llhttp_on_header_value_complete_cb;
     intern->settings.on_headers_complete = llhttp_on_headers_complete_cb;
     intern->settings.on_body = llhttp_on_body_cb;
     intern->settings.on_message_complete = llhttp_on_message_complete_cb;
+    intern->settings.on_chunk_extension_name = llhttp_on_chunk_extension_name_cb;
+    intern->settings.on_chunk_extension_name_complete = llhttp_on_chunk_extension_name_complete_cb;
+    intern->settings.on_chunk_extension_value = llhttp_on_chunk_extension_value_cb;
+    intern->settings.on_chunk_extension_value_complete = llhttp_on_chunk_extension_value_complete_cb;
+    intern->settings.on_chunk_header = llhttp_on_chunk_header_cb;
     
     llhttp_init(&intern->parser, (llhttp_type_t)type, &intern->settings);
     
@@ -114,6 +426,128 @@ PHP_METHOD(LlhttpParser, __construct) {
     intern->parser.data = intern;
 }
 
+/* Per-call bookkeeping; one clock reading per call serves every callback it triggers */
+void llhttp_parser_begin(llhttp_parser_object *intern, size_t length) {
+    intern->parse_time = llhttp_monotonic_ns();
+    if (length > 0) {
+        intern->timing_last_progress = intern->parse_time;
+        intern->total_bytes += length;
+        LLHTTP_G(stats).bytes += length;
+    }
+    
+    /* Batched events describe this call only */
+    intern->batch_count = 0;
+}
+
+/* Run llhttp over one chunk; a pause at message end requested by a Connection is not an error */
+llhttp_errno_t llhttp_parser_execute(llhttp_parser_object *intern, const char *data, size_t length) {
+    intern->state = LLHTTP_STATE_PARSING;
+    intern->parse_base = data;
+    intern->parse_offset = intern->total_bytes - length;
+    intern->executing = 1;
+    llhttp_errno_t err = llhttp_execute(&intern->parser, data, length);
+    intern->executing = 0;
+    
+    /* A single flag test when the histogram is off */
+    if (LLHTTP_G(latency_histogram)) {
+        llhttp_latency_record(llhttp_get_type(&intern->parser), llhttp_monotonic_ns() - intern->parse_time);
+    }
+    
+    if (err != HPE_OK && !(intern->pause_on_complete && (err == HPE_PAUSED || err == HPE_PAUSED_UPGRADE))) {
+        intern->state = LLHTTP_STATE_ERROR;
+        llhttp_stats_error(err);
+        if (intern->trace_size) {
+            llhttp_trace_record(intern, LLHTTP_TRACE_ERROR, llhttp_get_error_pos(&intern->parser), 0, (uint8_t)err);
+        }
+    }
+    
+    /* Cleared only after the error trace, which needs it for the error offset */
+    intern->parse_base = NULL;
+    
+    return err;
+}
+
+/* Report a parse failure; an exception from a userland callback propagates as is */
+void llhttp_parser_throw(llhttp_parser_object *intern, llhttp_errno_t err, const char *prefix) {
+    if (EG(exception)) {
+        return;
+    }
+    
+    const char *error_reason = llhttp_get_error_reason(&intern->parser);
+    char error_msg[256];
+    snprintf(error_msg, sizeof(error_msg), "%s: %s", prefix, error_reason ? error_reason : "Unknown error");
+    zend_throw_exception(llhttp_exception_ce, error_msg, err);
+}
+
+/* Drop everything collected for the latest message, keeping reusable storage */
+void llhttp_parser_clear_message(llhttp_parser_object *intern) {
+    /* Clear headers, dropping a table shared with the head cache or userland */
+    if (GC_REFCOUNT(intern->headers) > 1) {
+        GC_DELREF(intern->headers);
+        intern->headers = zend_new_array(16);
+    } else {
+        zend_hash_clean(intern->headers);
+    }
+    zend_hash_clean(intern->trailers);
+    
+    /* Clear current header strings */
+    if (intern->current_header_field) {
+        zend_string_release(intern->current_header_field);
+        intern->current_header_field = NULL;
+    }
+    if (intern->current_header_value) {
+        zend_string_release(intern->current_header_value);
+        intern->current_header_value = NULL;
+    }
+    
+    /* Keep the raw header arena for reuse */
+    intern->raw_arena_used = 0;
+    intern->raw_header_count = 0;
+    
+    /* Clear data strings */
+    if (intern->url) {
+        zend_string_release(intern->url);
+        intern->url = NULL;
+    }
+    if (intern->body) {
+        zend_string_release(intern->body);
+        intern->body = NULL;
+    }
+    intern->body_length = 0;
+    
+    /* Clear chunk data */
+    zend_hash_clean(intern->chunks);
+    llhttp_clear_chunk_extensions(intern);
+    
+    /* Clear body decoder */
+    if (intern->decoder) {
+        llhttp_body_decoder_free(intern->decoder);
+        intern->decoder = NULL;
+    }
+    intern->body_decoded = 0;
+    
+    /* Clear form data */
+    llhttp_form_clear(intern);
+    
+    /* Clear multipart data and remove its temp files */
+    llhttp_multipart_free(intern->multipart);
+    intern->multipart = NULL;
+    llhttp_multipart_clear_parts(intern);
+    intern->body_streamed = 0;
+    
+    /* Clear cookie index */
+    llhttp_cookie_clear(intern);
+    
+    /* Clear message framing */
+    intern->message_flags = 0;
+    intern->message_content_length = 0;
+    intern->message_upgrade = 0;
+    intern->message_header_bytes = 0;
+    intern->message_header_count = 0;
+    intern->message_url_length = 0;
+    intern->message_body_bytes = 0;
+    llhttp_fingerprint_reset(&intern->fingerprint);
+}
 
 /* parse(string $data): void */
 PHP_METHOD(LlhttpParser, parse) {
@@ -125,23 +559,52 @@ PHP_METHOD(LlhttpParser, parse) {
     
     llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
     
+    LLHTTP_CHECK_NOT_EXECUTING(intern, "parse");
+    
     if (intern->finished) {
         zend_throw_exception(llhttp_exception_ce, "Parser has already finished", 0);
         RETURN_THROWS();
     }
     
-    /* Set parsing state */
-    intern->state = LLHTTP_STATE_PARSING;
+    llhttp_parser_begin(intern, ZSTR_LEN(data));
+    
+    /* Identical bodiless heads can reuse an earlier parse result */
+    zend_bool cacheable = llhttp_head_cache_candidate(intern, data);
+    uint64_t head_hash = 0;
+    
+    if (cacheable) {
+        head_hash = llhttp_hash64(ZSTR_VAL(data), ZSTR_LEN(data));
+        if (llhttp_head_cache_lookup(intern, data, head_hash)) {
+            if (LLHTTP_G(latency_histogram)) {
+                llhttp_latency_record(llhttp_get_type(&intern->parser), llhttp_monotonic_ns() - intern->parse_time);
+            }
+            LLHTTP_G(stats).head_cache_hits++;
+            LLHTTP_G(stats).messages++;
+            llhttp_stats_headers(intern->message_header_count);
+            intern->timing_first_byte = intern->parse_time;
+            intern->timing_headers_complete = intern->parse_time;
+            intern->timing_message_complete = intern->parse_time;
+            intern->state = LLHTTP_STATE_PARSING;
+            return;
+        }
+        LLHTTP_G(stats).head_cache_misses++;
+    }
     
     /* Execute parser */
-    llhttp_errno_t err = llhttp_execute(&intern->parser, ZSTR_VAL(data), ZSTR_LEN(data));
+    llhttp_errno_t err = llhttp_parser_execute(intern, ZSTR_VAL(data), ZSTR_LEN(data));
     
     if (err != HPE_OK) {
         intern->state = LLHTTP_STATE_ERROR;
-        const char *error_reason = llhttp_get_error_reason(&intern->parser);
-        char error_msg[256];
-        snprintf(error_msg, sizeof(error_msg), "Parse error: %s", error_reason ? error_reason : "Unknown error");
-        zend_throw_exception(llhttp_exception_ce, error_msg, err);
+        llhttp_parser_throw(intern, err, "Parse error");
+        RETURN_THROWS();
+    }
+    
+    if (cacheable && intern->message_count == 1) {
+        llhttp_head_cache_store(intern, data, head_hash);
+    }
+    
+    if (llhttp_events_batch_deliver(intern, data) == FAILURE) {
+        intern->state = LLHTTP_STATE_ERROR;
         RETURN_THROWS();
     }
 }
@@ -152,23 +615,34 @@ PHP_METHOD(LlhttpParser, parseComplete) {
     
     llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
     
+    LLHTTP_CHECK_NOT_EXECUTING(intern, "parseComplete");
+    
     if (intern->finished) {
         return;
     }
     
+    intern->batch_count = 0;
+    
+    intern->executing = 1;
     llhttp_errno_t err = llhttp_finish(&intern->parser);
+    intern->executing = 0;
     
     if (err != HPE_OK) {
         intern->state = LLHTTP_STATE_ERROR;
-        const char *error_reason = llhttp_get_error_reason(&intern->parser);
-        char error_msg[256];
-        snprintf(error_msg, sizeof(error_msg), "Parse completion error: %s", error_reason ? error_reason : "Unknown error");
-        zend_throw_exception(llhttp_exception_ce, error_msg, err);
+        llhttp_stats_error(err);
+        if (intern->trace_size) {
+            llhttp_trace_record(intern, LLHTTP_TRACE_ERROR, NULL, 0, (uint8_t)err);
+        }
+        llhttp_parser_throw(intern, err, "Parse completion error");
         RETURN_THROWS();
     }
     
     intern->finished = 1;
     intern->state = LLHTTP_STATE_COMPLETE;
+    
+    if (llhttp_events_batch_deliver(intern, ZSTR_EMPTY_ALLOC()) == FAILURE) {
+        RETURN_THROWS();
+    }
 }
 
 /* reset(): void */
@@ -177,33 +651,25 @@ PHP_METHOD(LlhttpParser, reset) {
     
     llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
     
+    LLHTTP_CHECK_NOT_EXECUTING(intern, "reset");
+    
     /* Reset parser state */
     llhttp_reset(&intern->parser);
     intern->state = LLHTTP_STATE_INIT;
     intern->finished = 0;
     
-    /* Clear headers */
-    zend_hash_clean(intern->headers);
+    llhttp_parser_clear_message(intern);
+    intern->message_count = 0;
     
-    /* Clear current header strings */
-    if (intern->current_header_field) {
-        zend_string_release(intern->current_header_field);
-        intern->current_header_field = NULL;
-    }
-    if (intern->current_header_value) {
-        zend_string_release(intern->current_header_value);
-        intern->current_header_value = NULL;
-    }
+    /* Clear progress tracking */
+    intern->timing_first_byte = 0;
+    intern->timing_headers_complete = 0;
+    intern->timing_message_complete = 0;
+    intern->timing_last_progress = 0;
+    intern->total_bytes = 0;
     
-    /* Clear data strings */
-    if (intern->url) {
-        zend_string_release(intern->url);
-        intern->url = NULL;
-    }
-    if (intern->body) {
-        zend_string_release(intern->body);
-        intern->body = NULL;
-    }
+    /* Empty the trace ring, keeping its storage */
+    intern->trace_next = 0;
 }
 
 /* isComplete(): bool */
@@ -265,6 +731,43 @@ PHP_METHOD(LlhttpParser, getStatusCode) {
     RETURN_LONG(llhttp_get_status_code(&intern->parser));
 }
 
+/* getContentLength(): ?int */
+PHP_METHOD(LlhttpParser, getContentLength) {
+    ZEND_PARSE_PARAMETERS_NONE();
+    
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    
+    /* Value llhttp parsed from the Content-Length header, before the body counted it down */
+    if (!(intern->message_flags & F_CONTENT_LENGTH) || intern->message_content_length > ZEND_LONG_MAX) {
+        RETURN_NULL();
+    }
+    RETURN_LONG((zend_long)intern->message_content_length);
+}
+
+/* isChunked(): bool */
+PHP_METHOD(LlhttpParser, isChunked) {
+    ZEND_PARSE_PARAMETERS_NONE();
+    
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    RETURN_BOOL(intern->message_flags & F_CHUNKED);
+}
+
+/* isUpgrade(): bool */
+PHP_METHOD(LlhttpParser, isUpgrade) {
+    ZEND_PARSE_PARAMETERS_NONE();
+    
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    RETURN_BOOL(intern->message_upgrade);
+}
+
+/* getConnectionFlags(): int */
+PHP_METHOD(LlhttpParser, getConnectionFlags) {
+    ZEND_PARSE_PARAMETERS_NONE();
+    
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    RETURN_LONG(intern->message_flags & (F_CONNECTION_KEEP_ALIVE | F_CONNECTION_CLOSE | F_CONNECTION_UPGRADE));
+}
+
 /* shouldKeepAlive(): bool */
 PHP_METHOD(LlhttpParser, shouldKeepAlive) {
     ZEND_PARSE_PARAMETERS_NONE();
@@ -287,17 +790,9 @@ PHP_METHOD(LlhttpParser, getHeaders) {
     
     llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
     
-    /* Return copy of headers array */
-    array_init(return_value);
-    
-    if (intern->headers) {
-        zend_string *key;
-        zval *val;
-        ZEND_HASH_FOREACH_STR_KEY_VAL(intern->headers, key, val) {
-            Z_TRY_ADDREF_P(val);
-            zend_hash_update(Z_ARRVAL_P(return_value), key, val);
-        } ZEND_HASH_FOREACH_END();
-    }
+    /* Share the table; whoever writes first separates (copy-on-write) */
+    GC_ADDREF(intern->headers);
+    RETURN_ARR(intern->headers);
 }
 
 /* getHeader(string $name): ?string */
@@ -326,6 +821,37 @@ PHP_METHOD(LlhttpParser, getHeader) {
     RETURN_NULL();
 }
 
+/* getTrailers(): array */
+PHP_METHOD(LlhttpParser, getTrailers) {
+    ZEND_PARSE_PARAMETERS_NONE();
+    
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    
+    RETURN_ARR(zend_array_dup(intern->trailers));
+}
+
+/* getRawHeaders(): array */
+PHP_METHOD(LlhttpParser, getRawHeaders) {
+    uint32_t i;
+    
+    ZEND_PARSE_PARAMETERS_NONE();
+    
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    
+    array_init_size(return_value, intern->raw_header_count);
+    
+    /* [name, value] pairs, in the order and casing they were sent */
+    for (i = 0; i < intern->raw_header_count; i++) {
+        const llhttp_header_span *span = &intern->raw_headers[i];
+        zval pair;
+        
+        array_init_size(&pair, 2);
+        add_next_index_stringl(&pair, intern->raw_arena + span->name_offset, span->name_length);
+        add_next_index_stringl(&pair, intern->raw_arena + span->value_offset, span->value_length);
+        add_next_index_zval(return_value, &pair);
+    }
+}
+
 /* getUrl(): string */
 PHP_METHOD(LlhttpParser, getUrl) {
     ZEND_PARSE_PARAMETERS_NONE();
@@ -352,36 +878,50 @@ PHP_METHOD(LlhttpParser, getBody) {
     RETURN_EMPTY_STRING();
 }
 
+/* getChunks(): array */
+PHP_METHOD(LlhttpParser, getChunks) {
+    ZEND_PARSE_PARAMETERS_NONE();
+    
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    
+    RETURN_ARR(zend_array_dup(intern->chunks));
+}
+
+/* isBodyDecoded(): bool */
+PHP_METHOD(LlhttpParser, isBodyDecoded) {
+    ZEND_PARSE_PARAMETERS_NONE();
+    
+    llhttp_parser_object *intern = llhttp_parser_object_from_zend_object(Z_OBJ_P(ZEND_THIS));
+    RETURN_BOOL(intern->body_decoded);
+}
+
 /* Helper functions */
-void llhttp_append_url(llhttp_parser_object *parser_obj, const char *at, size_t length) {
+void llhttp_append_string(zend_string **dest, const char *at, size_t length) {
     if (length == 0) return;
     
-    if (parser_obj->url == NULL) {
-        parser_obj->url = zend_string_init(at, length, 0);
+    if (*dest == NULL) {
+        *dest = zend_string_init(at, length, 0);
     } else {
-        size_t old_len = ZSTR_LEN(parser_obj->url);
-        parser_obj->url = zend_string_extend(parser_obj->url, old_len + length, 0);
-        memcpy(ZSTR_VAL(parser_obj->url) + old_len, at, length);
-        ZSTR_VAL(parser_obj->url)[old_len + length] = '\0';
+        size_t old_len = ZSTR_LEN(*dest);
+        *dest = zend_string_extend(*dest, old_len + length, 0);
+        LLHTTP_G(stats).reallocations++;
+        memcpy(ZSTR_VAL(*dest) + old_len, at, length);
+        ZSTR_VAL(*dest)[old_len + length] = '\0';
     }
 }
 
+void llhttp_append_url(llhttp_parser_object *parser_obj, const char *at, size_t length) {
+    llhttp_append_string(&parser_obj->url, at, length);
+}
+
 void llhttp_append_body(llhttp_parser_object *parser_obj, const char *at, size_t length) {
-    if (length == 0) return;
-    
-    if (parser_obj->body == NULL) {
-        parser_obj->body = zend_string_init(at, length, 0);
-    } else {
-        size_t old_len = ZSTR_LEN(parser_obj->body);
-        parser_obj->body = zend_string_extend(parser_obj->body, old_len + length, 0);
-        memcpy(ZSTR_VAL(parser_obj->body) + old_len, at, length);
-        ZSTR_VAL(parser_obj->body)[old_len + length] = '\0';
-    }
+    llhttp_append_string(&parser_obj->body, at, length);
 }
 
 /* Arginfo declarations */
 ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_construct, 0, 0, 1)
     ZEND_ARG_TYPE_INFO(0, type, IS_LONG, 0)
+    ZEND_ARG_TYPE_INFO(0, options, IS_ARRAY, 0)
 ZEND_END_ARG_INFO()
 
 ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_parse, 0, 0, 1)
@@ -412,6 +952,13 @@ ZEND_END_ARG_INFO()
 ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getUrl, 0, 0, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getUrlParts, 0, 0, 0)
+    ZEND_ARG_TYPE_INFO(0, offsets, _IS_BOOL, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getQuery, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getHeaders, 0, 0, 0)
 ZEND_END_ARG_INFO()
 
@@ -419,9 +966,68 @@ ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getHeader, 0, 0, 1)
     ZEND_ARG_TYPE_INFO(0, name, IS_STRING, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getTrailers, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getCookies, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getCookie, 0, 0, 1)
+    ZEND_ARG_TYPE_INFO(0, name, IS_STRING, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getRawHeaders, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getFingerprint, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getTiming, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getTrace, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getEvents, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_on, 0, 0, 2)
+    ZEND_ARG_TYPE_INFO(0, event, IS_STRING, 0)
+    ZEND_ARG_TYPE_INFO(0, callback, IS_CALLABLE, 1)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getBody, 0, 0, 0)
 ZEND_END_ARG_INFO()
 
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getChunks, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_isBodyDecoded, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getForm, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getParts, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getContentLength, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_isChunked, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_isUpgrade, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_getConnectionFlags, 0, 0, 0)
+ZEND_END_ARG_INFO()
+
+ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_negotiate, 0, 0, 2)
+    ZEND_ARG_TYPE_INFO(0, header, IS_STRING, 0)
+    ZEND_ARG_TYPE_INFO(0, available, IS_ARRAY, 0)
+ZEND_END_ARG_INFO()
+
 ZEND_BEGIN_ARG_INFO_EX(arginfo_llhttp_parser_shouldKeepAlive, 0, 0, 0)
 ZEND_END_ARG_INFO()
 
@@ -439,6 +1045,10 @@ const zend_function_entry llhttp_parser_methods[] = {
     PHP_ME(LlhttpParser, __construct,       arginfo_llhttp_parser_construct, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, parse,             arginfo_llhttp_parser_parse, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, parseComplete,     arginfo_llhttp_parser_parseComplete, ZEND_ACC_PUBLIC)
+    PHP_MALIAS(LlhttpParser, execute, parse, arginfo_llhttp_parser_parse, ZEND_ACC_PUBLIC)
+    PHP_MALIAS(LlhttpParser, finish, parseComplete, arginfo_llhttp_parser_parseComplete, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, on,                arginfo_llhttp_parser_on, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getEvents,         arginfo_llhttp_parser_getEvents, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, reset,             arginfo_llhttp_parser_reset, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, getHttpMajor,      arginfo_llhttp_parser_getHttpMajor, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, getHttpMinor,      arginfo_llhttp_parser_getHttpMinor, ZEND_ACC_PUBLIC)
@@ -446,9 +1056,27 @@ const zend_function_entry llhttp_parser_methods[] = {
     PHP_ME(LlhttpParser, getMethodName,     arginfo_llhttp_parser_getMethodName, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, getStatusCode,     arginfo_llhttp_parser_getStatusCode, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, getUrl,            arginfo_llhttp_parser_getUrl, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getUrlParts,       arginfo_llhttp_parser_getUrlParts, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getQuery,          arginfo_llhttp_parser_getQuery, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, getHeaders,        arginfo_llhttp_parser_getHeaders, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, getHeader,         arginfo_llhttp_parser_getHeader, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getTrailers,       arginfo_llhttp_parser_getTrailers, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getRawHeaders,     arginfo_llhttp_parser_getRawHeaders, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getCookies,        arginfo_llhttp_parser_getCookies, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getCookie,         arginfo_llhttp_parser_getCookie, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getFingerprint,    arginfo_llhttp_parser_getFingerprint, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getTiming,         arginfo_llhttp_parser_getTiming, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getTrace,          arginfo_llhttp_parser_getTrace, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, getBody,           arginfo_llhttp_parser_getBody, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getChunks,         arginfo_llhttp_parser_getChunks, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, isBodyDecoded,     arginfo_llhttp_parser_isBodyDecoded, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getForm,           arginfo_llhttp_parser_getForm, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getParts,          arginfo_llhttp_parser_getParts, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getContentLength,  arginfo_llhttp_parser_getContentLength, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, isChunked,         arginfo_llhttp_parser_isChunked, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, isUpgrade,         arginfo_llhttp_parser_isUpgrade, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, getConnectionFlags, arginfo_llhttp_parser_getConnectionFlags, ZEND_ACC_PUBLIC)
+    PHP_ME(LlhttpParser, negotiate,         arginfo_llhttp_parser_negotiate, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, shouldKeepAlive,   arginfo_llhttp_parser_shouldKeepAlive, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, messageNeedsEof,   arginfo_llhttp_parser_messageNeedsEof, ZEND_ACC_PUBLIC)
     PHP_ME(LlhttpParser, isComplete,        arginfo_llhttp_parser_isComplete, ZEND_ACC_PUBLIC)
@@ -458,11 +1086,21 @@ const zend_function_entry llhttp_parser_methods[] = {
 
 /* External declarations for method entries */
 extern const zend_function_entry llhttp_error_codes_methods[];
+extern const zend_function_entry llhttp_request_writer_methods[];
+extern const zend_function_entry llhttp_chunked_encoder_methods[];
+extern const zend_function_entry llhttp_stats_methods[];
+extern const zend_function_entry llhttp_events_methods[];
+extern const zend_function_entry llhttp_connection_methods[];
+#ifdef HAVE_SYS_EPOLL_H
+extern const zend_function_entry llhttp_server_methods[];
+#endif
 
 /* Module initialization */
 PHP_MINIT_FUNCTION(llhttp) {
     zend_class_entry ce;
     
+    REGISTER_INI_ENTRIES();
+    
     /* Register Parser class */
     INIT_CLASS_ENTRY(ce, "Llhttp\\Parser", llhttp_parser_methods);
     llhttp_parser_ce = zend_register_internal_class(&ce);
@@ -472,6 +1110,7 @@ PHP_MINIT_FUNCTION(llhttp) {
     memcpy(&llhttp_parser_object_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
     llhttp_parser_object_handlers.offset = XtOffsetOf(llhttp_parser_object, std);
     llhttp_parser_object_handlers.free_obj = llhttp_parser_object_free;
+    llhttp_parser_object_handlers.get_gc = llhttp_parser_object_get_gc;
     
     /* Register constants */
     zend_declare_class_constant_long(llhttp_parser_ce, "TYPE_BOTH", sizeof("TYPE_BOTH")-1, LLHTTP_TYPE_BOTH);
@@ -484,6 +1123,11 @@ PHP_MINIT_FUNCTION(llhttp) {
     zend_declare_class_constant_long(llhttp_parser_ce, "STATE_COMPLETE", sizeof("STATE_COMPLETE")-1, LLHTTP_STATE_COMPLETE);
     zend_declare_class_constant_long(llhttp_parser_ce, "STATE_ERROR", sizeof("STATE_ERROR")-1, LLHTTP_STATE_ERROR);
     
+    /* Add connection flag constants to Parser class */
+    zend_declare_class_constant_long(llhttp_parser_ce, "CONNECTION_KEEP_ALIVE", sizeof("CONNECTION_KEEP_ALIVE")-1, LLHTTP_CONNECTION_KEEP_ALIVE);
+    zend_declare_class_constant_long(llhttp_parser_ce, "CONNECTION_CLOSE", sizeof("CONNECTION_CLOSE")-1, LLHTTP_CONNECTION_CLOSE);
+    zend_declare_class_constant_long(llhttp_parser_ce, "CONNECTION_UPGRADE", sizeof("CONNECTION_UPGRADE")-1, LLHTTP_CONNECTION_UPGRADE);
+    
     /* Register ErrorCodes class */
     INIT_CLASS_ENTRY(ce, "Llhttp\\ErrorCodes", llhttp_error_codes_methods);
     llhttp_error_codes_ce = zend_register_internal_class(&ce);
@@ -513,11 +1157,87 @@ PHP_MINIT_FUNCTION(llhttp) {
     INIT_CLASS_ENTRY(ce, "Llhttp\\Exception", NULL);
     llhttp_exception_ce = zend_register_internal_class_ex(&ce, zend_ce_exception);
     
+    /* Register RequestWriter class */
+    INIT_CLASS_ENTRY(ce, "Llhttp\\RequestWriter", llhttp_request_writer_methods);
+    llhttp_request_writer_ce = zend_register_internal_class(&ce);
+    
+    /* Register ChunkedEncoder class */
+    INIT_CLASS_ENTRY(ce, "Llhttp\\ChunkedEncoder", llhttp_chunked_encoder_methods);
+    llhttp_chunked_encoder_ce = zend_register_internal_class(&ce);
+    llhttp_chunked_encoder_ce->create_object = llhttp_chunked_encoder_object_create;
+    
+    memcpy(&llhttp_chunked_encoder_object_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+    llhttp_chunked_encoder_object_handlers.offset = XtOffsetOf(llhttp_chunked_encoder_object, std);
+    llhttp_chunked_encoder_object_handlers.clone_obj = NULL;
+    
+    /* Register Events class */
+    INIT_CLASS_ENTRY(ce, "Llhttp\\Events", llhttp_events_methods);
+    llhttp_events_ce = zend_register_internal_class(&ce);
+    
+    zend_declare_class_constant_string(llhttp_events_ce, "MESSAGE_BEGIN", sizeof("MESSAGE_BEGIN")-1, LLHTTP_EVENT_MESSAGE_BEGIN);
+    zend_declare_class_constant_string(llhttp_events_ce, "URL", sizeof("URL")-1, LLHTTP_EVENT_URL);
+    zend_declare_class_constant_string(llhttp_events_ce, "STATUS", sizeof("STATUS")-1, LLHTTP_EVENT_STATUS);
+    zend_declare_class_constant_string(llhttp_events_ce, "HEADER_FIELD", sizeof("HEADER_FIELD")-1, LLHTTP_EVENT_HEADER_FIELD);
+    zend_declare_class_constant_string(llhttp_events_ce, "HEADER_VALUE", sizeof("HEADER_VALUE")-1, LLHTTP_EVENT_HEADER_VALUE);
+    zend_declare_class_constant_string(llhttp_events_ce, "HEADERS_COMPLETE", sizeof("HEADERS_COMPLETE")-1, LLHTTP_EVENT_HEADERS_COMPLETE);
+    zend_declare_class_constant_string(llhttp_events_ce, "BODY", sizeof("BODY")-1, LLHTTP_EVENT_BODY);
+    zend_declare_class_constant_string(llhttp_events_ce, "MESSAGE_COMPLETE", sizeof("MESSAGE_COMPLETE")-1, LLHTTP_EVENT_MESSAGE_COMPLETE);
+    
+    /* Register Stats class */
+    INIT_CLASS_ENTRY(ce, "Llhttp\\Stats", llhttp_stats_methods);
+    llhttp_stats_ce = zend_register_internal_class(&ce);
+    
+    /* Register Connection class */
+    INIT_CLASS_ENTRY(ce, "Llhttp\\Connection", llhttp_connection_methods);
+    llhttp_connection_ce = zend_register_internal_class(&ce);
+    llhttp_connection_ce->create_object = llhttp_connection_object_create;
+    
+    memcpy(&llhttp_connection_object_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+    llhttp_connection_object_handlers.offset = XtOffsetOf(llhttp_connection_object, std);
+    llhttp_connection_object_handlers.free_obj = llhttp_connection_object_free;
+    llhttp_connection_object_handlers.get_gc = llhttp_connection_object_get_gc;
+    llhttp_connection_object_handlers.clone_obj = NULL;
+    
+#ifdef HAVE_SYS_EPOLL_H
+    /* Register Server class */
+    INIT_CLASS_ENTRY(ce, "Llhttp\\Server", llhttp_server_methods);
+    llhttp_server_ce = zend_register_internal_class(&ce);
+    llhttp_server_ce->create_object = llhttp_server_object_create;
+    
+    memcpy(&llhttp_server_object_handlers, zend_get_std_object_handlers(), sizeof(zend_object_handlers));
+    llhttp_server_object_handlers.offset = XtOffsetOf(llhttp_server_object, std);
+    llhttp_server_object_handlers.free_obj = llhttp_server_object_free;
+    llhttp_server_object_handlers.get_gc = llhttp_server_object_get_gc;
+    llhttp_server_object_handlers.clone_obj = NULL;
+#endif
+    
+    return SUCCESS;
+}
+
+/* Globals initialization */
+static PHP_GINIT_FUNCTION(llhttp) {
+#if defined(COMPILE_DL_LLHTTP) && defined(ZTS)
+    ZEND_TSRMLS_CACHE_UPDATE();
+#endif
+    memset(llhttp_globals, 0, sizeof(*llhttp_globals));
+}
+
+/* Globals shutdown */
+static PHP_GSHUTDOWN_FUNCTION(llhttp) {
+    for (int i = 0; i < LLHTTP_NEGOTIATE_CACHE_SIZE; i++) {
+        llhttp_negotiate_entry_free(&llhttp_globals->negotiate_cache[i]);
+    }
+}
+
+/* Request shutdown */
+PHP_RSHUTDOWN_FUNCTION(llhttp) {
+    llhttp_head_cache_clear();
     return SUCCESS;
 }
 
 /* Module shutdown */
 PHP_MSHUTDOWN_FUNCTION(llhttp) {
+    UNREGISTER_INI_ENTRIES();
     return SUCCESS;
 }
 
@@ -526,7 +1246,25 @@ PHP_MINFO_FUNCTION(llhttp) {
     php_info_print_table_start();
     php_info_print_table_header(2, "llhttp support", "enabled");
     php_info_print_table_row(2, "Extension version", PHP_LLHTTP_VERSION);
+#ifdef HAVE_LLHTTP_ZLIB
+    php_info_print_table_row(2, "gzip/deflate body decoding", "enabled");
+#else
+    php_info_print_table_row(2, "gzip/deflate body decoding", "disabled");
+#endif
+#ifdef HAVE_LLHTTP_BROTLI
+    php_info_print_table_row(2, "brotli body decoding", "enabled");
+#else
+    php_info_print_table_row(2, "brotli body decoding", "disabled");
+#endif
+#ifdef HAVE_SYS_EPOLL_H
+    php_info_print_table_row(2, "epoll server", "enabled");
+#else
+    php_info_print_table_row(2, "epoll server", "disabled");
+#endif
+    llhttp_stats_info();
     php_info_print_table_end();
+    
+    DISPLAY_INI_ENTRIES();
 }
 
 /* Module entry */
@@ -537,10 +1275,14 @@ zend_module_entry llhttp_module_entry = {
     PHP_MINIT(llhttp),
     PHP_MSHUTDOWN(llhttp),
     NULL,                       /* request startup */
-    NULL,                       /* request shutdown */
+    PHP_RSHUTDOWN(llhttp),
     PHP_MINFO(llhttp),
     PHP_LLHTTP_VERSION,
-    STANDARD_MODULE_PROPERTIES
+    PHP_MODULE_GLOBALS(llhttp),
+    PHP_GINIT(llhttp),
+    PHP_GSHUTDOWN(llhttp),
+    NULL,                       /* post deactivate */
+    STANDARD_MODULE_PROPERTIES_EX
 };
 
 #ifdef COMPILE_DL_LLHTTP
@@ -28,6 +28,95 @@ extern zend_module_entry llhttp_module_entry;
 /* Forward declarations */
 typedef struct _llhttp_parser_object llhttp_parser_object;
 typedef struct _llhttp_callback_data llhttp_callback_data;
+typedef struct _llhttp_chunked_encoder_object llhttp_chunked_encoder_object;
+typedef struct _llhttp_connection_object llhttp_connection_object;
+typedef struct _llhttp_server_object llhttp_server_object;
+typedef struct _llhttp_body_decoder llhttp_body_decoder;
+typedef struct _llhttp_multipart llhttp_multipart;
+
+/* Order-preserving header fingerprint, built as headers complete */
+typedef struct _llhttp_fingerprint {
+    uint64_t order_hash;
+    uint64_t content_hash;
+    uint32_t header_count;
+    zend_bool has_cookie;
+    zend_bool has_referer;
+    char language[4];
+} llhttp_fingerprint;
+
+/* Cookie name/value, as offsets into the cookie header */
+typedef struct _llhttp_cookie_span {
+    size_t name_offset;
+    size_t name_length;
+    size_t value_offset;
+    size_t value_length;
+} llhttp_cookie_span;
+
+/* Header name/value, as offsets into the raw header arena */
+typedef struct _llhttp_header_span {
+    uint32_t name_offset;
+    uint32_t name_length;
+    uint32_t value_offset;
+    uint32_t value_length;
+} llhttp_header_span;
+
+/* Trace ring entry; offset is UINT64_MAX for events without data */
+typedef struct _llhttp_trace_entry {
+    uint64_t offset;
+    uint32_t length;
+    uint16_t flags;
+    uint8_t event;
+    uint8_t code;
+} llhttp_trace_entry;
+
+#define LLHTTP_TRACE_MESSAGE_BEGIN         0
+#define LLHTTP_TRACE_URL                   1
+#define LLHTTP_TRACE_STATUS                2
+#define LLHTTP_TRACE_HEADER_FIELD          3
+#define LLHTTP_TRACE_HEADER_VALUE          4
+#define LLHTTP_TRACE_HEADER_COMPLETE       5
+#define LLHTTP_TRACE_HEADERS_COMPLETE      6
+#define LLHTTP_TRACE_BODY                  7
+#define LLHTTP_TRACE_MESSAGE_COMPLETE      8
+#define LLHTTP_TRACE_CHUNK_HEADER          9
+#define LLHTTP_TRACE_CHUNK_EXTENSION_NAME  10
+#define LLHTTP_TRACE_CHUNK_EXTENSION_VALUE 11
+#define LLHTTP_TRACE_ERROR                 12
+
+/* Largest accepted "trace" option */
+#define LLHTTP_MAX_TRACE_SIZE 65536
+
+/* Event names for Parser::on() and the Events class */
+#define LLHTTP_EVENT_MESSAGE_BEGIN    "message_begin"
+#define LLHTTP_EVENT_URL              "url"
+#define LLHTTP_EVENT_STATUS           "status"
+#define LLHTTP_EVENT_HEADER_FIELD     "header_field"
+#define LLHTTP_EVENT_HEADER_VALUE     "header_value"
+#define LLHTTP_EVENT_HEADERS_COMPLETE "headers_complete"
+#define LLHTTP_EVENT_BODY             "body"
+#define LLHTTP_EVENT_MESSAGE_COMPLETE "message_complete"
+
+#define LLHTTP_EVENT_ID_MESSAGE_BEGIN    0
+#define LLHTTP_EVENT_ID_URL              1
+#define LLHTTP_EVENT_ID_STATUS           2
+#define LLHTTP_EVENT_ID_HEADER_FIELD     3
+#define LLHTTP_EVENT_ID_HEADER_VALUE     4
+#define LLHTTP_EVENT_ID_HEADERS_COMPLETE 5
+#define LLHTTP_EVENT_ID_BODY             6
+#define LLHTTP_EVENT_ID_MESSAGE_COMPLETE 7
+#define LLHTTP_EVENT_COUNT               8
+
+#define LLHTTP_EVENT_BIT(event) (1u << (event))
+
+/* Set in event_mask while batchEvents records every event */
+#define LLHTTP_EVENT_BATCH (1u << 31)
+
+/* Batched event record; offset is into the current parse() input, SIZE_MAX without data */
+typedef struct _llhttp_batch_record {
+    size_t offset;
+    uint32_t length;
+    uint8_t event;
+} llhttp_batch_record;
 
 /* Parser object structure */
 struct _llhttp_parser_object {
@@ -40,12 +129,117 @@ struct _llhttp_parser_object {
     
     /* Header collection */
     HashTable *headers;
+    HashTable *trailers;
     zend_string *current_header_field;
     zend_string *current_header_value;
     
+    /* Headers of the current message in original order and casing, reused across messages */
+    char *raw_arena;
+    size_t raw_arena_used;
+    size_t raw_arena_size;
+    llhttp_header_span *raw_headers;
+    uint32_t raw_header_count;
+    uint32_t raw_header_capacity;
+    
     /* Data storage */
     zend_string *url;
     zend_string *body;
+    size_t body_length;
+    
+    /* Chunk collection */
+    HashTable *chunks;
+    HashTable *chunk_extensions;
+    zend_string *chunk_ext_name;
+    zend_string *chunk_ext_value;
+    zend_bool chunk_ext_name_done;
+    
+    /* Content-Encoding decoding (opt-in) */
+    zend_bool decompress;
+    zend_long max_decompressed_size;
+    llhttp_body_decoder *decoder;
+    zend_bool body_decoded;
+    
+    /* Streaming urlencoded form decoding (opt-in) */
+    zend_bool parse_form;
+    zend_long max_form_fields;
+    zend_long max_form_field_size;
+    zend_bool form_active;
+    HashTable *form;
+    zend_string *form_pending;
+    zend_long form_fields;
+    
+    /* Streaming multipart/form-data decoding (opt-in) */
+    zend_bool parse_multipart;
+    zval multipart_sink;
+    llhttp_multipart *multipart;
+    HashTable *parts;
+    
+    /* The current body went to the form or multipart decoder, not getBody() */
+    zend_bool body_streamed;
+    
+    /* Cookie index and decoded values, built on first use */
+    zend_bool cookies_indexed;
+    zend_string *cookie_source;
+    llhttp_cookie_span *cookie_spans;
+    uint32_t cookie_count;
+    uint32_t cookie_capacity;
+    HashTable *cookie_values;
+    
+    /* Framing of the current message, kept past llhttp clearing its flags */
+    uint16_t message_flags;
+    uint64_t message_content_length;
+    zend_bool message_upgrade;
+    uint32_t message_count;
+    
+    /* Hard limits, 0 = unlimited, and the current message's usage against them */
+    zend_long max_header_bytes;
+    zend_long max_headers;
+    zend_long max_url_length;
+    zend_long max_body_size;
+    uint64_t message_header_bytes;
+    uint32_t message_header_count;
+    uint64_t message_url_length;
+    uint64_t message_body_bytes;
+    
+    /* Progress timestamps (monotonic ns, 0 = not yet) and bytes fed since reset */
+    uint64_t parse_time;
+    uint64_t timing_first_byte;
+    uint64_t timing_headers_complete;
+    uint64_t timing_message_complete;
+    uint64_t timing_last_progress;
+    uint64_t total_bytes;
+    
+    /* Input of the running parse() call, for span offsets */
+    const char *parse_base;
+    uint64_t parse_offset;
+    
+    /* Callback event ring (opt-in), allocated once */
+    llhttp_trace_entry *trace;
+    uint32_t trace_size;
+    uint64_t trace_next;
+    
+    /* Event subscriptions; callbacks only dispatch for bits set in event_mask */
+    uint32_t event_mask;
+    zval event_callbacks[LLHTTP_EVENT_COUNT];
+    zend_fcall_info_cache event_fcc[LLHTTP_EVENT_COUNT];
+    
+    /* Events of the latest parse() call (opt-in), kept as C records until read */
+    llhttp_batch_record *batch;
+    uint32_t batch_count;
+    uint32_t batch_capacity;
+    zval batch_callback;
+    
+    /* Set while a Connection owns the parser: each message ends in a pause */
+    zend_bool pause_on_complete;
+    
+    /* Set while llhttp runs, so callbacks cannot re-enter or reset the parser */
+    zend_bool executing;
+    
+    /* Fingerprint of the current message's headers */
+    llhttp_fingerprint fingerprint;
+    
+    /* Head cache lookups (opt-in) */
+    zend_bool cache_heads;
     
     /* State management */
     int state;
@@ -59,19 +253,224 @@ struct _llhttp_callback_data {
     size_t length;
 };
 
+/* Chunked encoder object structure */
+struct _llhttp_chunked_encoder_object {
+    zend_bool finished;
+    zend_object std;
+};
+
+/* Connection read buffer size, default and upper bound */
+#define LLHTTP_CONNECTION_READ_SIZE     8192
+#define LLHTTP_CONNECTION_MAX_READ_SIZE (1024 * 1024)
+
+/* Connection object structure: a stream read straight into a parser */
+struct _llhttp_connection_object {
+    zval stream;
+    zval parser;
+    char *buffer;
+    size_t buffer_size;
+    size_t buffer_start;
+    size_t buffer_end;
+    zend_bool closed;
+    zend_object std;
+};
+
+/* Server receive buffer, shared by all connections, and events per epoll_wait() */
+#define LLHTTP_SERVER_READ_SIZE 65536
+#define LLHTTP_SERVER_EVENTS    64
+
+/* Parser limits for Server connections unless its options set them */
+#define LLHTTP_SERVER_MAX_HEADER_BYTES (64 * 1024)
+#define LLHTTP_SERVER_MAX_HEADERS      100
+#define LLHTTP_SERVER_MAX_URL_LENGTH   (8 * 1024)
+#define LLHTTP_SERVER_MAX_BODY_SIZE    (8 * 1024 * 1024)
+
+/* One accepted connection; partial requests live in its parser */
+typedef struct _llhttp_server_client {
+    int fd;
+    zend_long id;
+    zval parser;
+    char *output;
+    size_t output_length;
+    size_t output_sent;
+    size_t output_capacity;
+    uint32_t pending;
+    zend_bool writable_armed;
+    zend_bool keep_alive;
+    zend_bool draining;
+    zend_bool rejected;
+    zend_bool closing;
+} llhttp_server_client;
+
+/* Server object structure: a listener and its clients in one epoll set */
+struct _llhttp_server_object {
+    int listen_fd;
+    int epoll_fd;
+    zend_long port;
+    zend_long next_id;
+    HashTable clients;
+    zval options;
+    zval held;
+    char *buffer;
+    zend_object std;
+};
+
+/* Request-target components, as offsets into the URL */
+#define LLHTTP_URL_FORM_ORIGIN    0
+#define LLHTTP_URL_FORM_ABSOLUTE  1
+#define LLHTTP_URL_FORM_AUTHORITY 2
+#define LLHTTP_URL_FORM_ASTERISK  3
+
+typedef struct _llhttp_url_span {
+    size_t offset;
+    size_t length;
+    zend_bool present;
+} llhttp_url_span;
+
+typedef struct _llhttp_url_parts {
+    int form;
+    llhttp_url_span scheme;
+    llhttp_url_span userinfo;
+    llhttp_url_span host;
+    llhttp_url_span port;
+    llhttp_url_span path;
+    llhttp_url_span query;
+    llhttp_url_span fragment;
+} llhttp_url_parts;
+
+/* Accept-* range, as an offset into the header value */
+typedef struct _llhttp_accept_range {
+    uint32_t offset;
+    uint32_t length;
+    uint16_t q;  /* quality in thousandths */
+} llhttp_accept_range;
+
+/* Negotiation cache entry, in persistent memory */
+typedef struct _llhttp_negotiate_entry {
+    zend_string *header;
+    zend_ulong hash;
+    llhttp_accept_range *ranges;
+    uint32_t count;
+    uint64_t last_used;
+} llhttp_negotiate_entry;
+
+#define LLHTTP_NEGOTIATE_CACHE_SIZE       16
+#define LLHTTP_NEGOTIATE_CACHE_MAX_LENGTH 1024
+
+/* Head cache entry: a parse result shared by identical request heads */
+typedef struct _llhttp_head_cache_entry {
+    zend_string *head;
+    uint64_t hash;
+    int type;
+    llhttp_t parser;
+    HashTable *headers;
+    zend_string *url;
+    char *raw_arena;
+    size_t raw_arena_used;
+    llhttp_header_span *raw_headers;
+    uint32_t raw_header_count;
+    uint16_t message_flags;
+    uint64_t message_content_length;
+    zend_bool message_upgrade;
+    uint64_t message_header_bytes;
+    uint32_t message_header_count;
+    uint64_t message_url_length;
+    llhttp_fingerprint fingerprint;
+    uint64_t last_used;
+} llhttp_head_cache_entry;
+
+#define LLHTTP_HEAD_CACHE_SIZE       64
+#define LLHTTP_HEAD_CACHE_MAX_LENGTH 4096
+
+/* Module-wide counters for Llhttp\Stats and phpinfo() */
+#define LLHTTP_STATS_ERROR_CODES   40
+#define LLHTTP_STATS_HEADER_BUCKETS 6
+
+typedef struct _llhttp_stats {
+    uint64_t messages;
+    uint64_t bytes;
+    uint64_t body_bytes;
+    uint64_t errors[LLHTTP_STATS_ERROR_CODES];
+    uint64_t header_histogram[LLHTTP_STATS_HEADER_BUCKETS];
+    uint64_t reallocations;
+    uint64_t head_cache_hits;
+    uint64_t head_cache_misses;
+    uint64_t negotiate_cache_hits;
+    uint64_t negotiate_cache_misses;
+} llhttp_stats;
+
+/* Log-linear latency histogram: 16 sub-buckets per power of two, up to 2^40 ns */
+#define LLHTTP_LATENCY_SUB_BUCKETS 16
+#define LLHTTP_LATENCY_BUCKETS     ((40 - 3) * LLHTTP_LATENCY_SUB_BUCKETS)
+
+typedef struct _llhttp_latency_histogram {
+    uint64_t count;
+    uint64_t max;
+    uint64_t buckets[LLHTTP_LATENCY_BUCKETS];
+} llhttp_latency_histogram;
+
 /* Class entry declarations */
 extern zend_class_entry *llhttp_parser_ce;
 extern zend_class_entry *llhttp_error_codes_ce;
 extern zend_class_entry *llhttp_exception_ce;
+extern zend_class_entry *llhttp_request_writer_ce;
+extern zend_class_entry *llhttp_chunked_encoder_ce;
+extern zend_class_entry *llhttp_stats_ce;
+extern zend_class_entry *llhttp_events_ce;
+extern zend_class_entry *llhttp_connection_ce;
+extern zend_class_entry *llhttp_server_ce;
 
 /* Object handlers */
 extern zend_object_handlers llhttp_parser_object_handlers;
+extern zend_object_handlers llhttp_chunked_encoder_object_handlers;
+extern zend_object_handlers llhttp_connection_object_handlers;
+extern zend_object_handlers llhttp_server_object_handlers;
+
+/* Parser object accessor */
+static inline llhttp_parser_object *llhttp_parser_object_from_zend_object(zend_object *obj) {
+    return (llhttp_parser_object *)((char *)(obj) - XtOffsetOf(llhttp_parser_object, std));
+}
+
+static inline llhttp_chunked_encoder_object *llhttp_chunked_encoder_object_from_zend_object(zend_object *obj) {
+    return (llhttp_chunked_encoder_object *)((char *)(obj) - XtOffsetOf(llhttp_chunked_encoder_object, std));
+}
+
+static inline llhttp_connection_object *llhttp_connection_object_from_zend_object(zend_object *obj) {
+    return (llhttp_connection_object *)((char *)(obj) - XtOffsetOf(llhttp_connection_object, std));
+}
+
+static inline llhttp_server_object *llhttp_server_object_from_zend_object(zend_object *obj) {
+    return (llhttp_server_object *)((char *)(obj) - XtOffsetOf(llhttp_server_object, std));
+}
 
 /* Parser type constants - must match llhttp library values */
 #define LLHTTP_TYPE_BOTH     0  /* HTTP_BOTH */
 #define LLHTTP_TYPE_REQUEST  1  /* HTTP_REQUEST */
 #define LLHTTP_TYPE_RESPONSE 2  /* HTTP_RESPONSE */
 
+/* Default cap on decoded body size when decompression is enabled */
+#define LLHTTP_DEFAULT_MAX_DECOMPRESSED_SIZE (16 * 1024 * 1024)
+
+/* Default form limits when form parsing is enabled */
+#define LLHTTP_DEFAULT_MAX_FORM_FIELDS     1000
+#define LLHTTP_DEFAULT_MAX_FORM_FIELD_SIZE (1024 * 1024)
+
+/* Methods that drive or reset llhttp may not run from inside one of its callbacks */
+#define LLHTTP_CHECK_NOT_EXECUTING(intern, method) do { \
+        if (UNEXPECTED((intern)->executing)) { \
+            zend_throw_exception(llhttp_exception_ce, "Cannot call " method "() from a parser callback", 0); \
+            RETURN_THROWS(); \
+        } \
+    } while (0)
+
+/* True when a limit is set and the value is past it */
+#define LLHTTP_LIMIT_EXCEEDED(max, value) ((max) > 0 && (uint64_t)(value) > (uint64_t)(max))
+
+/* Connection header flags - must match llhttp F_CONNECTION_* values */
+#define LLHTTP_CONNECTION_KEEP_ALIVE 0x1  /* F_CONNECTION_KEEP_ALIVE */
+#define LLHTTP_CONNECTION_CLOSE      0x2  /* F_CONNECTION_CLOSE */
+#define LLHTTP_CONNECTION_UPGRADE    0x4  /* F_CONNECTION_UPGRADE */
+
 /* Parser state constants */
 #define LLHTTP_STATE_INIT        0
 #define LLHTTP_STATE_PARSING     1
@@ -83,6 +482,7 @@ extern zend_object_handlers llhttp_parser_object_handlers;
 /* Module functions */
 PHP_MINIT_FUNCTION(llhttp);
 PHP_MSHUTDOWN_FUNCTION(llhttp);
+PHP_RSHUTDOWN_FUNCTION(llhttp);
 PHP_MINFO_FUNCTION(llhttp);
 
 /* Parser class methods */
@@ -96,9 +496,29 @@ PHP_METHOD(LlhttpParser, getMethod);
 PHP_METHOD(LlhttpParser, getMethodName);
 PHP_METHOD(LlhttpParser, getStatusCode);
 PHP_METHOD(LlhttpParser, getUrl);
+PHP_METHOD(LlhttpParser, getUrlParts);
+PHP_METHOD(LlhttpParser, getQuery);
 PHP_METHOD(LlhttpParser, getHeaders);
 PHP_METHOD(LlhttpParser, getHeader);
+PHP_METHOD(LlhttpParser, getTrailers);
+PHP_METHOD(LlhttpParser, getRawHeaders);
+PHP_METHOD(LlhttpParser, getCookies);
+PHP_METHOD(LlhttpParser, getCookie);
+PHP_METHOD(LlhttpParser, getFingerprint);
+PHP_METHOD(LlhttpParser, getTiming);
+PHP_METHOD(LlhttpParser, getTrace);
+PHP_METHOD(LlhttpParser, on);
+PHP_METHOD(LlhttpParser, getEvents);
 PHP_METHOD(LlhttpParser, getBody);
+PHP_METHOD(LlhttpParser, getChunks);
+PHP_METHOD(LlhttpParser, isBodyDecoded);
+PHP_METHOD(LlhttpParser, getForm);
+PHP_METHOD(LlhttpParser, getParts);
+PHP_METHOD(LlhttpParser, getContentLength);
+PHP_METHOD(LlhttpParser, isChunked);
+PHP_METHOD(LlhttpParser, isUpgrade);
+PHP_METHOD(LlhttpParser, getConnectionFlags);
+PHP_METHOD(LlhttpParser, negotiate);
 PHP_METHOD(LlhttpParser, shouldKeepAlive);
 PHP_METHOD(LlhttpParser, messageNeedsEof);
 PHP_METHOD(LlhttpParser, isComplete);
@@ -107,6 +527,37 @@ PHP_METHOD(LlhttpParser, getState);
 /* ErrorCodes class methods */
 PHP_METHOD(LlhttpErrorCodes, getMessage);
 
+/* RequestWriter class methods */
+PHP_METHOD(LlhttpRequestWriter, fromParser);
+
+/* Events class methods */
+PHP_METHOD(LlhttpEvents, getAll);
+PHP_METHOD(LlhttpEvents, isValid);
+
+/* Stats class methods */
+PHP_METHOD(LlhttpStats, get);
+PHP_METHOD(LlhttpStats, reset);
+PHP_METHOD(LlhttpStats, latency);
+
+/* ChunkedEncoder class methods */
+PHP_METHOD(LlhttpChunkedEncoder, encode);
+PHP_METHOD(LlhttpChunkedEncoder, finish);
+
+/* Connection class methods */
+PHP_METHOD(LlhttpConnection, __construct);
+PHP_METHOD(LlhttpConnection, readMessage);
+PHP_METHOD(LlhttpConnection, getParser);
+PHP_METHOD(LlhttpConnection, getStream);
+PHP_METHOD(LlhttpConnection, getBuffered);
+
+/* Server class methods */
+PHP_METHOD(LlhttpServer, __construct);
+PHP_METHOD(LlhttpServer, poll);
+PHP_METHOD(LlhttpServer, send);
+PHP_METHOD(LlhttpServer, close);
+PHP_METHOD(LlhttpServer, getPort);
+PHP_METHOD(LlhttpServer, getConnectionCount);
+
 /* Utility functions - declared static inline or static in .c file */
 
 /* Callback functions */
@@ -115,22 +566,148 @@ int llhttp_on_url_cb(llhttp_t *parser, const char *at, size_t length);
 int llhttp_on_status_cb(llhttp_t *parser, const char *at, size_t length);
 int llhttp_on_header_field_cb(llhttp_t *parser, const char *at, size_t length);
 int llhttp_on_header_value_cb(llhttp_t *parser, const char *at, size_t length);
+int llhttp_on_header_value_complete_cb(llhttp_t *parser);
 int llhttp_on_headers_complete_cb(llhttp_t *parser);
 int llhttp_on_body_cb(llhttp_t *parser, const char *at, size_t length);
 int llhttp_on_message_complete_cb(llhttp_t *parser);
+int llhttp_on_chunk_extension_name_cb(llhttp_t *parser, const char *at, size_t length);
+int llhttp_on_chunk_extension_name_complete_cb(llhttp_t *parser);
+int llhttp_on_chunk_extension_value_cb(llhttp_t *parser, const char *at, size_t length);
+int llhttp_on_chunk_extension_value_complete_cb(llhttp_t *parser);
+int llhttp_on_chunk_header_cb(llhttp_t *parser);
 
 /* Helper functions */
 void llhttp_add_header(llhttp_parser_object *parser_obj, zend_string *field, zend_string *value);
 void llhttp_finalize_current_header(llhttp_parser_object *parser_obj);
+void llhttp_headers_separate(llhttp_parser_object *parser_obj);
+void llhttp_raw_header_add(llhttp_parser_object *parser_obj, zend_string *field, zend_string *value);
+void llhttp_raw_headers_set(llhttp_parser_object *parser_obj, const char *arena, size_t used,
+                            const llhttp_header_span *spans, uint32_t count);
+void llhttp_append_string(zend_string **dest, const char *at, size_t length);
+void llhttp_clear_chunk_extensions(llhttp_parser_object *parser_obj);
 void llhttp_append_url(llhttp_parser_object *parser_obj, const char *at, size_t length);
 void llhttp_append_body(llhttp_parser_object *parser_obj, const char *at, size_t length);
+int llhttp_deliver_body(llhttp_parser_object *parser_obj, const char *at, size_t length);
+zend_bool llhttp_is_valid_header_name(zend_string *name);
+zend_bool llhttp_is_valid_header_value(zend_string *value);
+
+/* URL helpers */
+void llhttp_url_split(const char *url, size_t len, llhttp_url_parts *parts);
+const char *llhttp_urlencoded_find_escape(const char *p, const char *end);
+size_t llhttp_urldecode_into(char *dst, const char *src, size_t len);
+zend_string *llhttp_urldecode(const char *src, size_t len);
+void llhttp_urlencoded_add_pair(HashTable *dest, const char *pair, size_t len);
+void llhttp_urlencoded_parse(HashTable *dest, const char *src, size_t len);
+
+/* Body decoder */
+llhttp_body_decoder *llhttp_body_decoder_create(zend_string *content_encoding);
+int llhttp_body_decoder_feed(llhttp_parser_object *parser_obj, const char *at, size_t length);
+zend_bool llhttp_body_decoder_finished(llhttp_body_decoder *decoder);
+void llhttp_body_decoder_free(llhttp_body_decoder *decoder);
+
+/* Cookies */
+void llhttp_cookie_clear(llhttp_parser_object *intern);
+
+/* Fingerprint */
+void llhttp_fingerprint_reset(llhttp_fingerprint *fp);
+void llhttp_fingerprint_header(llhttp_fingerprint *fp, zend_string *name, zend_string *value);
+
+/* Timing */
+uint64_t llhttp_monotonic_ns(void);
+
+/* Events */
+int llhttp_event_from_name(zend_string *name);
+const char *llhttp_event_name(int event);
+void llhttp_events_clear(llhttp_parser_object *parser_obj);
+int llhttp_event_dispatch(llhttp_parser_object *parser_obj, int event, const char *at, size_t length);
+void llhttp_events_batch_array(llhttp_parser_object *parser_obj, zval *dest);
+int llhttp_events_batch_deliver(llhttp_parser_object *parser_obj, zend_string *data);
+
+/* Record and/or dispatch an event, returning from the calling callback on error */
+#define LLHTTP_EMIT(parser_obj, event, at, length) do { \
+        if (UNEXPECTED((parser_obj)->event_mask & (LLHTTP_EVENT_BIT(event) | LLHTTP_EVENT_BATCH))) { \
+            int _emit_err = llhttp_event_dispatch((parser_obj), (event), (at), (length)); \
+            if (_emit_err) { \
+                return _emit_err; \
+            } \
+        } \
+    } while (0)
+
+/* Trace */
+void llhttp_trace_record(llhttp_parser_object *intern, uint8_t event, const char *at, size_t length, uint8_t code);
+
+#define LLHTTP_TRACE(intern, event, at, length) do { \
+        if (UNEXPECTED((intern)->trace_size)) { \
+            llhttp_trace_record((intern), (event), (at), (length), 0); \
+        } \
+    } while (0)
+
+/* Stats */
+void llhttp_stats_headers(uint32_t count);
+void llhttp_stats_error(int err);
+void llhttp_stats_info(void);
+void llhttp_latency_record(int type, uint64_t ns);
+
+/* Negotiation */
+void llhttp_negotiate_entry_free(llhttp_negotiate_entry *entry);
+
+/* Head cache */
+uint64_t llhttp_hash64(const char *p, size_t len);
+zend_bool llhttp_head_cache_candidate(llhttp_parser_object *intern, zend_string *data);
+zend_bool llhttp_head_cache_lookup(llhttp_parser_object *intern, zend_string *data, uint64_t hash);
+void llhttp_head_cache_store(llhttp_parser_object *intern, zend_string *data, uint64_t hash);
+void llhttp_head_cache_clear(void);
+
+/* Form decoder */
+zend_bool llhttp_media_type_is(zend_string *content_type, const char *type, size_t type_len);
+int llhttp_form_feed(llhttp_parser_object *parser_obj, const char *at, size_t length);
+void llhttp_form_finish(llhttp_parser_object *parser_obj);
+void llhttp_form_clear(llhttp_parser_object *parser_obj);
+
+/* Multipart decoder */
+llhttp_multipart *llhttp_multipart_create(zend_string *content_type);
+int llhttp_multipart_feed(llhttp_parser_object *parser_obj, const char *at, size_t length);
+void llhttp_multipart_free(llhttp_multipart *mp);
+void llhttp_multipart_clear_parts(llhttp_parser_object *parser_obj);
+
+/* Chunked encoder */
+zend_object *llhttp_chunked_encoder_object_create(zend_class_entry *ce);
+
+/* Shared parse() steps, also driven by Connection */
+void llhttp_parser_clear_message(llhttp_parser_object *intern);
+void llhttp_parser_begin(llhttp_parser_object *intern, size_t length);
+llhttp_errno_t llhttp_parser_execute(llhttp_parser_object *intern, const char *data, size_t length);
+void llhttp_parser_throw(llhttp_parser_object *intern, llhttp_errno_t err, const char *prefix);
+
+/* Connection */
+zend_object *llhttp_connection_object_create(zend_class_entry *ce);
+void llhttp_connection_object_free(zend_object *obj);
+HashTable *llhttp_connection_object_get_gc(zend_object *obj, zval **table, int *n);
+
+/* Server (epoll builds only) */
+zend_object *llhttp_server_object_create(zend_class_entry *ce);
+void llhttp_server_object_free(zend_object *obj);
+HashTable *llhttp_server_object_get_gc(zend_object *obj, zval **table, int *n);
 
 /* Error handling */
 void llhttp_throw_exception(int llhttp_errno, const char *message);
 
 /* Globals structure */
 ZEND_BEGIN_MODULE_GLOBALS(llhttp)
-    /* Add global variables if needed */
+    /* Counters for Llhttp\Stats */
+    llhttp_stats stats;
+    
+    /* parse() latency by request/response, when llhttp.latency_histogram is on */
+    zend_bool latency_histogram;
+    llhttp_latency_histogram latency[2];
+    
+    /* Per-worker LRU cache of parsed Accept-* headers */
+    llhttp_negotiate_entry negotiate_cache[LLHTTP_NEGOTIATE_CACHE_SIZE];
+    uint64_t negotiate_tick;
+    
+    /* Per-request cache of parsed request heads */
+    llhttp_head_cache_entry head_cache[LLHTTP_HEAD_CACHE_SIZE];
+    uint64_t head_cache_tick;
 ZEND_END_MODULE_GLOBALS(llhttp)
 
 #ifdef ZTS
@@ -0,0 +1,50 @@
+<?php
+
+use Llhttp\Parser;
+
+echo "=== Testing batched event delivery ===\n";
+
+try {
+    $data = "POST /items HTTP/1.1\r\nHost: x\r\nContent-Length: 2\r\n\r\nhi";
+
+    // Records are kept in C and read once per call
+    $parser = new Parser(Parser::TYPE_REQUEST, ['batchEvents' => true]);
+    $parser->parse($data);
+    foreach ($parser->getEvents() as [$event, $offset, $length]) {
+        $span = $offset === null ? '' : ' "' . substr($data, $offset, $length) . '"';
+        echo "$event$span\n";
+    }
+
+    // A callable receives each batch with the data it indexes
+    $calls = 0;
+    $parser = new Parser(Parser::TYPE_REQUEST, [
+        'batchEvents' => function (array $events, string $data) use (&$calls) {
+            $calls++;
+            echo "Batch of " . count($events) . " events over " . strlen($data) . " bytes\n";
+        },
+    ]);
+    $parser->parse("GET / HTTP/1.1\r\n");
+    $parser->parse("Host: x\r\n\r\n");
+    echo "Callback calls: $calls\n";
+
+    // A throwing batch callback reaches the caller
+    $parser = new Parser(Parser::TYPE_REQUEST, [
+        'batchEvents' => function () { throw new RuntimeException("batch rejected"); },
+    ]);
+    try {
+        $parser->parse("GET / HTTP/1.1\r\n\r\n");
+    } catch (RuntimeException $e) {
+        echo "Callback exception: " . $e->getMessage() . "\n";
+    }
+
+    try {
+        new Parser(Parser::TYPE_REQUEST, ['batchEvents' => 42]);
+    } catch (Llhttp\Exception $e) {
+        echo "Invalid option: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n=== Batched events test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
@@ -0,0 +1,38 @@
+<?php
+
+echo "=== Testing ChunkedEncoder ===\n";
+
+try {
+    $encoder = new Llhttp\ChunkedEncoder();
+
+    $stream = "HTTP/1.1 200 OK\r\n" .
+              "Content-Type: text/event-stream\r\n" .
+              "Transfer-Encoding: chunked\r\n" .
+              "\r\n";
+
+    $stream .= $encoder->encode("data: first\n\n");
+    $stream .= $encoder->encode("");
+    $stream .= $encoder->encode(str_repeat("x", 300));
+    $stream .= $encoder->finish(['Grpc-Status' => '0']);
+
+    echo "1. Encoded stream: " . json_encode(substr($stream, -40)) . "\n";
+
+    echo "\n2. Decoding with the parser...\n";
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_RESPONSE);
+    $parser->parse($stream);
+    echo "  - Body length: " . strlen($parser->getBody()) . "\n";
+    echo "  - Body starts with: " . json_encode(substr($parser->getBody(), 0, 13)) . "\n";
+
+    echo "\n3. Encoding after finish:\n";
+    try {
+        $encoder->encode("late");
+        echo "  - Not rejected\n";
+    } catch (Llhttp\Exception $e) {
+        echo "  - Rejected: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n=== ChunkedEncoder test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
@@ -0,0 +1,39 @@
+<?php
+
+echo "=== Testing chunk boundaries ===\n";
+
+try {
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_RESPONSE);
+
+    $response = "HTTP/1.1 200 OK\r\n" .
+                "Transfer-Encoding: chunked\r\n" .
+                "\r\n" .
+                "5;name=first\r\nhello\r\n" .
+                "7;flag;sig=\"abc\"\r\n, world\r\n" .
+                "0\r\n\r\n";
+
+    // Feed in small pieces so chunk headers and extensions are split
+    foreach (str_split($response, 7) as $piece) {
+        $parser->parse($piece);
+    }
+
+    $body = $parser->getBody();
+    echo "Body: $body\n";
+
+    foreach ($parser->getChunks() as $i => $chunk) {
+        echo "Chunk $i: offset=" . $chunk['offset'] . " length=" . $chunk['length'] .
+             " data=" . json_encode(substr($body, $chunk['offset'], $chunk['length'])) .
+             " extensions=" . json_encode($chunk['extensions']) . "\n";
+    }
+
+    // Numeric extension names are found with either key type, like query keys
+    $numeric = new Llhttp\Parser(Llhttp\Parser::TYPE_RESPONSE);
+    $numeric->parse("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n2;1=x\r\nok\r\n0\r\n\r\n");
+    $extensions = $numeric->getChunks()[0]['extensions'];
+    echo "Numeric extension: " . var_export($extensions['1'] ?? null, true) . "\n";
+
+    echo "\n=== Chunk test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
@@ -0,0 +1,64 @@
+<?php
+
+use Llhttp\Connection;
+use Llhttp\Parser;
+
+echo "=== Testing Fiber-aware connections ===\n";
+
+try {
+    [$server, $client] = stream_socket_pair(STREAM_PF_UNIX, STREAM_SOCK_STREAM, STREAM_IPPROTO_IP);
+    $connection = new Connection($server, new Parser(Parser::TYPE_REQUEST));
+
+    // readMessage() suspends with the connection when the socket has no data
+    $fiber = new Fiber(function () use ($connection) {
+        while ($connection->readMessage()) {
+            $parser = $connection->getParser();
+            echo "Request: " . $parser->getMethodName() . " " . $parser->getUrl() . " (" . count($parser->getHeaders()) . " headers, body '" . $parser->getBody() . "')\n";
+        }
+        echo "Peer closed\n";
+    });
+
+    $waiting = $fiber->start();
+    echo "Suspended with connection: " . ($waiting === $connection ? 'Yes' : 'No') . "\n";
+
+    // Two pipelined requests in one write, the second split across writes
+    fwrite($client, "GET /one HTTP/1.1\r\nHost: x\r\n\r\nPOST /two HTTP/1.1\r\nHost: x\r\n");
+    $fiber->resume();
+    fwrite($client, "Content-Length: 2\r\n\r\nhi");
+    $fiber->resume();
+    fclose($client);
+
+    // A minimal scheduler: resume while the stream is readable
+    while (!$fiber->isTerminated()) {
+        $read = [$connection->getStream()];
+        $write = $except = null;
+        if (stream_select($read, $write, $except, 1) > 0) {
+            $fiber->resume();
+        }
+    }
+
+    // Outside a Fiber the read waits for data instead
+    [$server, $client] = stream_socket_pair(STREAM_PF_UNIX, STREAM_SOCK_STREAM, STREAM_IPPROTO_IP);
+    $connection = new Connection($server, new Parser(Parser::TYPE_REQUEST), 16);
+    fwrite($client, "GET /blocking HTTP/1.1\r\nHost: x\r\n\r\n");
+    echo "Blocking read: " . ($connection->readMessage() ? 'message' : 'closed') . "\n";
+    echo "URL: " . $connection->getParser()->getUrl() . "\n";
+
+    fwrite($client, "BROKEN\r\n\r\n");
+    try {
+        $connection->readMessage();
+    } catch (Llhttp\Exception $e) {
+        echo "Parse error: " . $e->getMessage() . "\n";
+    }
+
+    try {
+        new Connection($server, new Parser(Parser::TYPE_REQUEST, ['batchEvents' => true]));
+    } catch (Llhttp\Exception $e) {
+        echo "Batched events: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n=== Connection test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
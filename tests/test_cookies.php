@@ -0,0 +1,26 @@
+<?php
+
+echo "=== Testing cookie parsing ===\n";
+
+try {
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $parser->parse("GET / HTTP/1.1\r\n" .
+                   "Host: example.com\r\n" .
+                   "Cookie: SID=31d4d96e407aad42; lang=en-US; greeting=hello%20world; quoted=\"abc\"; SID=shadowed; flag\r\n\r\n");
+
+    echo "SID: " . $parser->getCookie('SID') . "\n";
+    echo "greeting: " . $parser->getCookie('greeting') . "\n";
+    echo "missing: " . var_export($parser->getCookie('missing'), true) . "\n";
+    var_dump($parser->getCookies());
+
+    // Without a cookie header
+    $parser->reset();
+    $parser->parse("GET / HTTP/1.1\r\nHost: example.com\r\n\r\n");
+    echo "Cookies after reset: " . count($parser->getCookies()) . "\n";
+    echo "SID after reset: " . var_export($parser->getCookie('SID'), true) . "\n";
+
+    echo "\n=== Cookie test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
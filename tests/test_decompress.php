@@ -0,0 +1,66 @@
+<?php
+
+echo "=== Testing streaming body decompression ===\n";
+
+try {
+    $payload = str_repeat('{"id":1,"name":"llhttp"}', 200);
+    $compressed = gzencode($payload);
+
+    $response = "HTTP/1.1 200 OK\r\n" .
+                "Content-Encoding: gzip\r\n" .
+                "Content-Length: " . strlen($compressed) . "\r\n" .
+                "\r\n" .
+                $compressed;
+
+    echo "1. gzip body fed in 100-byte pieces...\n";
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_RESPONSE, ['decompress' => true]);
+    foreach (str_split($response, 100) as $piece) {
+        $parser->parse($piece);
+    }
+    echo "  - Decoded: " . ($parser->isBodyDecoded() ? 'Yes' : 'No') . "\n";
+    echo "  - Matches payload: " . ($parser->getBody() === $payload ? 'Yes' : 'No') . "\n";
+
+    echo "\n2. Without the option the body is left as sent...\n";
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_RESPONSE);
+    $parser->parse($response);
+    echo "  - Decoded: " . ($parser->isBodyDecoded() ? 'Yes' : 'No') . "\n";
+    echo "  - Compressed bytes kept: " . ($parser->getBody() === $compressed ? 'Yes' : 'No') . "\n";
+
+    echo "\n3. Decompressed size limit...\n";
+    $bomb = gzencode(str_repeat("\0", 1024 * 1024));
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_RESPONSE, [
+        'decompress' => true,
+        'maxDecompressedSize' => 64 * 1024,
+    ]);
+    try {
+        $parser->parse("HTTP/1.1 200 OK\r\nContent-Encoding: gzip\r\n" .
+                       "Content-Length: " . strlen($bomb) . "\r\n\r\n" . $bomb);
+        echo "  - Not rejected\n";
+    } catch (Llhttp\Exception $e) {
+        echo "  - Rejected: " . $e->getMessage() . " (code " . $e->getCode() . ")\n";
+    }
+
+    echo "\n4. Truncated compressed body...\n";
+    $cut = substr($compressed, 0, (int)(strlen($compressed) / 2));
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_RESPONSE, ['decompress' => true]);
+    try {
+        $parser->parse("HTTP/1.1 200 OK\r\nContent-Encoding: gzip\r\n" .
+                       "Content-Length: " . strlen($cut) . "\r\n\r\n" . $cut);
+        echo "  - Not rejected\n";
+    } catch (Llhttp\Exception $e) {
+        echo "  - Rejected: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n5. Re-emitting a decoded request drops Content-Encoding...\n";
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['decompress' => true]);
+    $parser->parse("POST /ingest HTTP/1.1\r\nHost: a\r\nContent-Encoding: gzip\r\n" .
+                   "Content-Length: " . strlen($compressed) . "\r\n\r\n" . $compressed);
+    $wire = Llhttp\RequestWriter::fromParser($parser);
+    echo "  - Content-Encoding kept: " . (stripos($wire, 'content-encoding') !== false ? 'Yes' : 'No') . "\n";
+    echo "  - Plain body: " . (substr($wire, -strlen($payload)) === $payload ? 'Yes' : 'No') . "\n";
+
+    echo "\n=== Decompression test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
@@ -0,0 +1,63 @@
+<?php
+
+use Llhttp\Parser;
+use Llhttp\Events;
+
+echo "=== Testing event subscriptions ===\n";
+
+try {
+    echo "Events: " . implode(', ', Events::getAll()) . "\n";
+    echo "Valid 'url': " . (Events::isValid('url') ? 'Yes' : 'No') . "\n";
+    echo "Valid 'bogus': " . (Events::isValid('bogus') ? 'Yes' : 'No') . "\n";
+
+    $parser = new Parser(Parser::TYPE_REQUEST);
+    $seen = [];
+    $parser->on(Events::URL, function ($url) use (&$seen) { $seen[] = "url $url"; });
+    $parser->on(Events::HEADERS_COMPLETE, function () use (&$seen, $parser) {
+        $seen[] = "headers " . count($parser->getHeaders());
+    });
+    $parser->on(Events::BODY, 'strtoupper');
+
+    // Unsubscribe again
+    $parser->on(Events::BODY, null);
+
+    $parser->parse("POST /items HTTP/1.1\r\nHost: x\r\nContent-Length: 2\r\n\r\nhi");
+    echo "Seen: " . implode(', ', $seen) . "\n";
+
+    try {
+        $parser->on('bogus', function () {});
+    } catch (Llhttp\Exception $e) {
+        echo "Unknown event: " . $e->getMessage() . "\n";
+    }
+
+    // A throwing callback aborts parsing and its exception reaches the caller
+    $parser = new Parser(Parser::TYPE_REQUEST);
+    $parser->on(Events::HEADER_FIELD, function ($field) {
+        throw new RuntimeException("rejected $field");
+    });
+    try {
+        $parser->parse("GET / HTTP/1.1\r\nX-Forbidden: 1\r\n\r\n");
+    } catch (RuntimeException $e) {
+        echo "Callback exception: " . $e->getMessage() . "\n";
+        echo "State is error: " . ($parser->getState() === Parser::STATE_ERROR ? 'Yes' : 'No') . "\n";
+    }
+
+    // Callbacks run inside llhttp, so they may not reset or re-enter the parser
+    foreach (['reset', 'parse'] as $method) {
+        $parser = new Parser(Parser::TYPE_REQUEST);
+        $parser->on(Events::HEADER_VALUE, function () use ($parser, $method) {
+            $method === 'reset' ? $parser->reset() : $parser->parse("GET / HTTP/1.1\r\n\r\n");
+        });
+        try {
+            $parser->parse("GET / HTTP/1.1\r\nHost: x\r\n\r\n");
+            echo "$method() from callback: allowed\n";
+        } catch (Llhttp\Exception $e) {
+            echo "$method() from callback: " . $e->getMessage() . "\n";
+        }
+    }
+
+    echo "\n=== Events test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
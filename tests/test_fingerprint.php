@@ -0,0 +1,42 @@
+<?php
+
+echo "=== Testing header fingerprint ===\n";
+
+try {
+    $head = "GET /index.html HTTP/1.1\r\n" .
+            "Host: example.com\r\n" .
+            "User-Agent: Mozilla/5.0\r\n" .
+            "Accept: text/html\r\n" .
+            "Accept-Language: en-US,en;q=0.9\r\n" .
+            "Cookie: session=abc\r\n" .
+            "Referer: https://example.com/\r\n\r\n";
+
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $parser->parse($head);
+    $fp = $parser->getFingerprint();
+    echo "Prefix: " . substr($fp['fingerprint'], 0, 13) . "\n";
+    echo "Header count: " . $fp['headerCount'] . "\n";
+    echo "Hash lengths: " . strlen($fp['headerOrderHash']) . "/" . strlen($fp['contentHash']) . "\n";
+
+    // Same headers in a different order give a different order hash
+    $reordered = str_replace("User-Agent: Mozilla/5.0\r\nAccept: text/html\r\n", "Accept: text/html\r\nUser-Agent: Mozilla/5.0\r\n", $head);
+    $other = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $other->parse($reordered);
+    echo "Order sensitive: " . ($other->getFingerprint()['headerOrderHash'] !== $fp['headerOrderHash'] ? 'Yes' : 'No') . "\n";
+
+    // Header casing is part of the fingerprint; values only change the content hash
+    $other = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $other->parse(str_replace("Mozilla/5.0", "curl/8.0", $head));
+    $changed = $other->getFingerprint();
+    echo "Value change keeps order hash: " . ($changed['headerOrderHash'] === $fp['headerOrderHash'] ? 'Yes' : 'No') . "\n";
+    echo "Value change alters content hash: " . ($changed['contentHash'] !== $fp['contentHash'] ? 'Yes' : 'No') . "\n";
+
+    $other = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $other->parse(str_replace("User-Agent:", "user-agent:", $head));
+    echo "Casing sensitive: " . ($other->getFingerprint()['headerOrderHash'] !== $fp['headerOrderHash'] ? 'Yes' : 'No') . "\n";
+
+    echo "\n=== Fingerprint test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
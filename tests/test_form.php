@@ -0,0 +1,54 @@
+<?php
+
+echo "=== Testing streaming form decoding ===\n";
+
+try {
+    $body = "name=J%C3%B6rg+M&city=Berlin&note=a%26b%3Dc&empty=&flag";
+
+    // Feed the body one byte at a time so fields straddle parse() calls
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['parseForm' => true]);
+    $parser->parse("POST /submit HTTP/1.1\r\n" .
+                   "Host: example.com\r\n" .
+                   "Content-Type: application/x-www-form-urlencoded; charset=UTF-8\r\n" .
+                   "Content-Length: " . strlen($body) . "\r\n\r\n");
+    foreach (str_split($body) as $byte) {
+        $parser->parse($byte);
+    }
+
+    $form = $parser->getForm();
+    var_dump($form);
+
+    parse_str($body, $expected);
+    echo "Matches parse_str(): " . ($form === $expected ? 'Yes' : 'No') . "\n";
+    echo "Body collected: " . ($parser->getBody() === '' ? 'No' : 'Yes') . "\n";
+
+    // Other content types are collected as usual
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['parseForm' => true]);
+    $parser->parse("POST /submit HTTP/1.1\r\nContent-Type: text/plain\r\nContent-Length: 3\r\n\r\na=b");
+    echo "Plain body: " . $parser->getBody() . ", form fields: " . count($parser->getForm()) . "\n";
+
+    // Field count limit
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['parseForm' => true, 'maxFormFields' => 2]);
+    try {
+        $parser->parse("POST / HTTP/1.1\r\nContent-Type: application/x-www-form-urlencoded\r\nContent-Length: 11\r\n\r\na=1&b=2&c=3");
+        echo "Field count limit: not enforced\n";
+    } catch (Llhttp\Exception $e) {
+        echo "Field count limit: " . $e->getMessage() . "\n";
+    }
+
+    // Field size limit
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['parseForm' => true, 'maxFormFieldSize' => 8]);
+    try {
+        $parser->parse("POST / HTTP/1.1\r\nContent-Type: application/x-www-form-urlencoded\r\nContent-Length: 16\r\n\r\n");
+        $parser->parse("a=1&long=");
+        $parser->parse("1234567");
+        echo "Field size limit: not enforced\n";
+    } catch (Llhttp\Exception $e) {
+        echo "Field size limit: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n=== Form test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
@@ -0,0 +1,29 @@
+<?php
+
+echo "=== Testing typed framing accessors ===\n";
+
+try {
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    echo "Before parsing: " . var_export($parser->getContentLength(), true) . "\n";
+
+    $parser->parse("POST /items HTTP/1.1\r\nHost: example.com\r\nConnection: keep-alive\r\nContent-Length: 11\r\n\r\nhello world");
+    echo "Content-Length: " . var_export($parser->getContentLength(), true) . "\n";
+    echo "Chunked: " . var_export($parser->isChunked(), true) . "\n";
+    echo "Keep-alive flag: " . (($parser->getConnectionFlags() & Llhttp\Parser::CONNECTION_KEEP_ALIVE) ? 'Yes' : 'No') . "\n";
+
+    $parser->reset();
+    $parser->parse("POST /stream HTTP/1.1\r\nHost: example.com\r\nConnection: close\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n0\r\n\r\n");
+    echo "Content-Length (chunked): " . var_export($parser->getContentLength(), true) . "\n";
+    echo "Chunked: " . var_export($parser->isChunked(), true) . "\n";
+    echo "Close flag: " . (($parser->getConnectionFlags() & Llhttp\Parser::CONNECTION_CLOSE) ? 'Yes' : 'No') . "\n";
+
+    $parser->reset();
+    $parser->parse("GET /ws HTTP/1.1\r\nHost: example.com\r\nConnection: Upgrade\r\nUpgrade: websocket\r\n\r\n");
+    echo "Upgrade: " . var_export($parser->isUpgrade(), true) . "\n";
+    echo "Upgrade flag: " . (($parser->getConnectionFlags() & Llhttp\Parser::CONNECTION_UPGRADE) ? 'Yes' : 'No') . "\n";
+
+    echo "\n=== Framing test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
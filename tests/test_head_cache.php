@@ -0,0 +1,43 @@
+<?php
+
+echo "=== Testing head cache ===\n";
+
+try {
+    $probe = "GET /healthz HTTP/1.1\r\nHost: backend.local\r\nUser-Agent: lb-probe/1.0\r\nCookie: a=1\r\n\r\n";
+
+    $first = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['cacheHeads' => true]);
+    $first->parse($probe);
+
+    // Identical heads are restored from the cache
+    $second = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['cacheHeads' => true]);
+    $second->parse($probe);
+    echo "Same headers: " . ($first->getHeaders() === $second->getHeaders() ? 'Yes' : 'No') . "\n";
+    echo "URL: " . $second->getUrl() . "\n";
+    echo "Method: " . $second->getMethodName() . "\n";
+    echo "Keep-alive: " . var_export($second->shouldKeepAlive(), true) . "\n";
+    echo "Cookie: " . $second->getCookie('a') . "\n";
+
+    // A cached parser keeps working on the next message of the connection
+    $second->parse("DELETE /next HTTP/1.1\r\nHost: backend.local\r\nX-Extra: 1\r\n\r\n");
+    echo "Next method: " . $second->getMethodName() . "\n";
+    echo "Extra header: " . $second->getHeader('X-Extra') . "\n";
+    echo "First parser untouched: " . var_export($first->getHeader('X-Extra'), true) . "\n";
+
+    // A traced parser always runs llhttp, so its trace is never empty
+    $traced = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['cacheHeads' => true, 'trace' => 16]);
+    $traced->parse($probe);
+    echo "Traced events: " . (count($traced->getTrace()) > 0 ? 'Yes' : 'No') . "\n";
+
+    // Heads with a body are never cached
+    $post = "POST /submit HTTP/1.1\r\nHost: backend.local\r\nContent-Length: 2\r\n\r\nok";
+    foreach ([1, 2] as $i) {
+        $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['cacheHeads' => true]);
+        $parser->parse($post);
+        echo "POST body $i: " . $parser->getBody() . "\n";
+    }
+
+    echo "\n=== Head cache test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
@@ -0,0 +1,34 @@
+<?php
+
+echo "=== Testing shared headers array ===\n";
+
+try {
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $parser->parse("GET / HTTP/1.1\r\nHost: example.com\r\nAccept: */*\r\n\r\n");
+
+    $a = $parser->getHeaders();
+    $b = $parser->getHeaders();
+    echo "Repeated calls equal: " . ($a === $b ? 'Yes' : 'No') . "\n";
+
+    // Writing to the returned array must not affect the parser
+    $a['host'] = 'evil.example';
+    $a['x-injected'] = '1';
+    echo "Parser host: " . $parser->getHeader('Host') . "\n";
+    echo "Parser has x-injected: " . var_export($parser->getHeader('X-Injected'), true) . "\n";
+
+    // Parsing more headers must not affect arrays already returned
+    $parser->parse("GET /next HTTP/1.1\r\nHost: example.org\r\nX-Second: yes\r\n\r\n");
+    echo "Earlier array host: " . $b['host'] . "\n";
+    echo "Earlier array has x-second: " . (isset($b['x-second']) ? 'Yes' : 'No') . "\n";
+    echo "Parser host now: " . $parser->getHeaders()['host'] . "\n";
+
+    // reset() leaves returned arrays intact
+    $c = $parser->getHeaders();
+    $parser->reset();
+    echo "Headers after reset: " . count($parser->getHeaders()) . ", kept copy: " . count($c) . "\n";
+
+    echo "\n=== Shared headers test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
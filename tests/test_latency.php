@@ -0,0 +1,40 @@
+<?php
+
+use Llhttp\Parser;
+use Llhttp\Stats;
+
+echo "=== Testing latency histogram ===\n";
+
+try {
+    Stats::reset();
+
+    // Off by default: nothing is recorded
+    ini_set('llhttp.latency_histogram', '0');
+    (new Parser(Parser::TYPE_REQUEST))->parse("GET / HTTP/1.1\r\nHost: a\r\n\r\n");
+    echo "Disabled count: " . Stats::latency()['request']['count'] . "\n";
+
+    ini_set('llhttp.latency_histogram', '1');
+    for ($i = 0; $i < 100; $i++) {
+        (new Parser(Parser::TYPE_REQUEST))->parse("GET /$i HTTP/1.1\r\nHost: a\r\n\r\n");
+    }
+    (new Parser(Parser::TYPE_RESPONSE))->parse("HTTP/1.1 204 No Content\r\n\r\n");
+
+    $latency = Stats::latency();
+    echo "Enabled: " . ($latency['enabled'] ? 'Yes' : 'No') . "\n";
+    echo "Request count: " . $latency['request']['count'] . "\n";
+    echo "Response count: " . $latency['response']['count'] . "\n";
+
+    $r = $latency['request'];
+    echo "Percentiles ordered: " . ($r['p50'] <= $r['p99'] && $r['p99'] <= $r['p999'] && $r['p999'] <= $r['max'] ? 'Yes' : 'No') . "\n";
+    echo "Positive p50: " . ($r['p50'] > 0 ? 'Yes' : 'No') . "\n";
+
+    Stats::reset();
+    echo "Count after reset: " . Stats::latency()['request']['count'] . "\n";
+
+    ini_set('llhttp.latency_histogram', '0');
+
+    echo "\n=== Latency test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
@@ -0,0 +1,53 @@
+<?php
+
+use Llhttp\Parser;
+use Llhttp\ErrorCodes;
+
+echo "=== Testing parser limits ===\n";
+
+function expectLimit(array $options, array $chunks, string $label) {
+    $parser = new Parser(Parser::TYPE_REQUEST, $options);
+    try {
+        foreach ($chunks as $chunk) {
+            $parser->parse($chunk);
+        }
+        echo "$label: accepted\n";
+    } catch (Llhttp\Exception $e) {
+        echo "$label: " . $e->getMessage() . " (" . ($e->getCode() === ErrorCodes::HPE_USER ? 'HPE_USER' : $e->getCode()) . ")\n";
+    }
+}
+
+try {
+    $head = "GET /path HTTP/1.1\r\nHost: example.com\r\nAccept: */*\r\n\r\n";
+
+    expectLimit(['maxHeaders' => 2], [$head], "Two headers, maxHeaders 2");
+    expectLimit(['maxHeaders' => 1], [$head], "Two headers, maxHeaders 1");
+
+    expectLimit(['maxHeaderBytes' => 64], [$head], "Small head, maxHeaderBytes 64");
+    expectLimit(['maxHeaderBytes' => 64], ["GET / HTTP/1.1\r\nX-Big: " . str_repeat('a', 100) . "\r\n\r\n"], "Large header, maxHeaderBytes 64");
+
+    // The limit holds even when the header trickles in across calls
+    expectLimit(['maxHeaderBytes' => 64], ["GET / HTTP/1.1\r\nX-Big: ", str_repeat('a', 40), str_repeat('a', 40), "\r\n\r\n"], "Split header, maxHeaderBytes 64");
+
+    expectLimit(['maxUrlLength' => 5], [$head], "URL /path, maxUrlLength 5");
+    expectLimit(['maxUrlLength' => 4], [$head], "URL /path, maxUrlLength 4");
+
+    $post = "POST /upload HTTP/1.1\r\nContent-Length: 10\r\n\r\n";
+    expectLimit(['maxBodySize' => 10], [$post, "0123456789"], "10-byte body, maxBodySize 10");
+    expectLimit(['maxBodySize' => 8], [$post, "01234", "56789"], "10-byte body, maxBodySize 8");
+
+    // Limits apply to each message, not the whole connection
+    expectLimit(['maxBodySize' => 10], [$post . "0123456789" . $post . "0123456789"], "Two 10-byte bodies, maxBodySize 10");
+
+    try {
+        new Parser(Parser::TYPE_REQUEST, ['maxHeaders' => -1]);
+        echo "Negative limit: accepted\n";
+    } catch (Llhttp\Exception $e) {
+        echo "Negative limit: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n=== Limits test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
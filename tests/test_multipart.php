@@ -0,0 +1,83 @@
+<?php
+
+echo "=== Testing streaming multipart decoding ===\n";
+
+try {
+    $boundary = "----llhttpBoundary7MA4YWxkTrZu0gW";
+    $file = str_repeat("0123456789abcdef", 4096) . "\r\n--not-the-boundary\r\n";
+    $body = "preamble is ignored\r\n" .
+            "--$boundary\r\n" .
+            "Content-Disposition: form-data; name=\"title\"\r\n\r\n" .
+            "Hello, multipart\r\n" .
+            "--$boundary\r\n" .
+            "Content-Disposition: form-data; name=\"upload\"; filename=\"data.bin\"\r\n" .
+            "Content-Type: application/octet-stream\r\n\r\n" .
+            $file . "\r\n" .
+            "--$boundary--\r\n" .
+            "epilogue is ignored too";
+    $head = "POST /upload HTTP/1.1\r\n" .
+            "Host: example.com\r\n" .
+            "Content-Type: multipart/form-data; boundary=\"$boundary\"\r\n" .
+            "Content-Length: " . strlen($body) . "\r\n\r\n";
+
+    // Small spans so the boundary straddles parse() calls
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['parseMultipart' => true]);
+    $parser->parse($head);
+    foreach (str_split($body, 7) as $span) {
+        $parser->parse($span);
+    }
+
+    $parts = $parser->getParts();
+    echo "Parts: " . count($parts) . "\n";
+    echo "Field: " . $parts[0]['name'] . " = " . $parts[0]['value'] . "\n";
+    echo "File: " . $parts[1]['name'] . " (" . $parts[1]['filename'] . ", " . $parts[1]['headers']['content-type'] . ")\n";
+    echo "File size matches: " . ($parts[1]['size'] === strlen($file) ? 'Yes' : 'No') . "\n";
+    echo "Temp file content matches: " . (file_get_contents($parts[1]['tmpName']) === $file ? 'Yes' : 'No') . "\n";
+    echo "Body collected: " . ($parser->getBody() === '' ? 'No' : 'Yes') . "\n";
+
+    $tmpName = $parts[1]['tmpName'];
+    $parser->reset();
+    echo "Temp file removed on reset: " . (file_exists($tmpName) ? 'No' : 'Yes') . "\n";
+
+    // Callback sink receives every part as it streams
+    $received = [];
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, [
+        'parseMultipart' => true,
+        'multipartSink' => function (array $part, string $data, bool $final) use (&$received) {
+            $received[$part['name']] = ($received[$part['name']] ?? '') . $data;
+            if ($final) {
+                echo "Sink finished " . $part['name'] . " (" . $part['size'] . " bytes)\n";
+            }
+        },
+    ]);
+    $parser->parse($head . $body);
+    echo "Sink file matches: " . ($received['upload'] === $file ? 'Yes' : 'No') . "\n";
+
+    // The sink runs inside parse(), so it may not reset or re-enter the parser
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, [
+        'parseMultipart' => true,
+        'multipartSink' => function () use (&$parser) {
+            $parser->reset();
+        },
+    ]);
+    try {
+        $parser->parse($head . $body);
+        echo "Reset from sink: allowed\n";
+    } catch (Llhttp\Exception $e) {
+        echo "Reset from sink: " . $e->getMessage() . "\n";
+    }
+
+    // Part count limit
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['parseMultipart' => true, 'maxFormFields' => 1]);
+    try {
+        $parser->parse($head . $body);
+        echo "Part count limit: not enforced\n";
+    } catch (Llhttp\Exception $e) {
+        echo "Part count limit: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n=== Multipart test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
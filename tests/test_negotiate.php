@@ -0,0 +1,37 @@
+<?php
+
+echo "=== Testing content negotiation ===\n";
+
+try {
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $parser->parse("GET /report HTTP/1.1\r\n" .
+                   "Host: example.com\r\n" .
+                   "Accept: text/html, application/json;q=0.9, image/*;q=0.5, */*;q=0.1\r\n" .
+                   "Accept-Encoding: br;q=1.0, gzip;q=0.8, *;q=0\r\n" .
+                   "Accept-Language: en-US, en;q=0.8, de;q=0.5\r\n\r\n");
+
+    echo "Accept: " . $parser->negotiate('Accept', ['application/json', 'text/plain']) . "\n";
+    echo "Accept (wildcard type): " . $parser->negotiate('Accept', ['image/png', 'text/csv']) . "\n";
+    echo "Accept-Encoding: " . $parser->negotiate('Accept-Encoding', ['gzip', 'br']) . "\n";
+    echo "Accept-Encoding (refused): " . var_export($parser->negotiate('Accept-Encoding', ['deflate', 'identity']), true) . "\n";
+    echo "Accept-Language: " . $parser->negotiate('Accept-Language', ['de', 'en-GB']) . "\n";
+    echo "Missing header: " . $parser->negotiate('Accept-Charset', ['utf-8', 'iso-8859-1']) . "\n";
+
+    // Repeated header values are served from the per-worker cache
+    for ($i = 0; $i < 3; $i++) {
+        $parser->reset();
+        $parser->parse("GET / HTTP/1.1\r\nHost: example.com\r\nAccept-Encoding: gzip;q=0\r\n\r\n");
+        echo "Identity fallback: " . $parser->negotiate('Accept-Encoding', ['gzip', 'identity']) . "\n";
+    }
+
+    try {
+        $parser->negotiate('Accept', [42]);
+    } catch (Llhttp\Exception $e) {
+        echo "Invalid candidates: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n=== Negotiation test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
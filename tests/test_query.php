@@ -0,0 +1,20 @@
+<?php
+
+echo "=== Testing query string decoding ===\n";
+
+try {
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $parser->parse("GET /search?q=http+parser&lang=en&tag=a%26b&empty=&flag&=skipped&q2=%E3%81%82&42=answer HTTP/1.1\r\n" .
+                   "Host: example.com\r\n\r\n");
+
+    $query = $parser->getQuery();
+    var_dump($query);
+
+    parse_str(parse_url($parser->getUrl(), PHP_URL_QUERY), $expected);
+    echo "Matches parse_str(): " . ($query === $expected ? 'Yes' : 'No') . "\n";
+
+    echo "\n=== Query test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
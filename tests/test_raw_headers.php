@@ -0,0 +1,37 @@
+<?php
+
+echo "=== Testing raw headers ===\n";
+
+try {
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $parser->parse("GET / HTTP/1.1\r\n" .
+                   "Host: example.com\r\n" .
+                   "X-Forwarded-For: 10.0.0.1\r\n" .
+                   "x-forwarded-for: 10.0.0.2\r\n" .
+                   "X-Empty:\r\n\r\n");
+
+    foreach ($parser->getRawHeaders() as [$name, $value]) {
+        echo "$name: $value\n";
+    }
+
+    // The lowercase table still keeps only the last value
+    echo "Lowercase table: " . $parser->getHeader('x-forwarded-for') . "\n";
+
+    // A second message on the same connection replaces the list
+    $parser->parse("GET /next HTTP/1.1\r\nHOST: example.org\r\n\r\n");
+    echo "Second message: " . json_encode($parser->getRawHeaders()) . "\n";
+
+    // Headers split across parse() calls are recorded whole
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $parser->parse("GET / HTTP/1.1\r\nUser-Ag");
+    $parser->parse("ent: Test/1.0\r\n\r\n");
+    echo "Split header: " . json_encode($parser->getRawHeaders()) . "\n";
+
+    $parser->reset();
+    echo "After reset: " . count($parser->getRawHeaders()) . "\n";
+
+    echo "\n=== Raw headers test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
@@ -0,0 +1,77 @@
+<?php
+
+echo "=== Testing RequestWriter ===\n";
+
+try {
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+
+    $request = "POST /upload?id=7 HTTP/1.1\r\n" .
+               "Host: backend.local\r\n" .
+               "X-Forwarded-For: 10.0.0.1\r\n" .
+               "Cookie: session=abc\r\n" .
+               "Transfer-Encoding: chunked\r\n" .
+               "\r\n" .
+               "5\r\nhello\r\n" .
+               "6\r\n world\r\n" .
+               "0\r\n\r\n";
+
+    $parser->parse($request);
+
+    echo "1. Re-emit without overrides:\n";
+    echo json_encode(Llhttp\RequestWriter::fromParser($parser)) . "\n";
+
+    echo "\n2. Re-emit with add/remove/replace rules:\n";
+    $wire = Llhttp\RequestWriter::fromParser($parser, [
+        'Host' => 'upstream.local',
+        'Cookie' => null,
+        'Via' => ['1.1 proxy-a', '1.1 proxy-b'],
+    ]);
+    echo json_encode($wire) . "\n";
+
+    echo "\n3. Round trip through a new parser:\n";
+    $check = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $check->parse($wire);
+    echo "  - Method: " . $check->getMethodName() . "\n";
+    echo "  - URL: " . $check->getUrl() . "\n";
+    echo "  - Host: " . $check->getHeader('host') . "\n";
+    echo "  - Cookie: " . var_export($check->getHeader('cookie'), true) . "\n";
+    echo "  - Body: " . $check->getBody() . "\n";
+
+    echo "\n4. Rejecting header injection:\n";
+    try {
+        Llhttp\RequestWriter::fromParser($parser, ['X-Bad' => "a\r\nInjected: 1"]);
+        echo "  - Not rejected\n";
+    } catch (Llhttp\Exception $e) {
+        echo "  - Rejected: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n5. Repeated headers keep their order and casing:\n";
+    $proxied = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $proxied->parse("GET / HTTP/1.1\r\nHost: a\r\nX-Forwarded-For: 10.0.0.1\r\nx-forwarded-for: 10.0.0.2\r\nVia: 1.1 edge\r\n\r\n");
+    echo json_encode(Llhttp\RequestWriter::fromParser($proxied, ['via' => '1.1 proxy'])) . "\n";
+
+    echo "\n6. Rejecting an incomplete request:\n";
+    $partial = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $partial->parse("POST / HTTP/1.1\r\nHost: a\r\nContent-Length: 10\r\n\r\nhel");
+    try {
+        Llhttp\RequestWriter::fromParser($partial);
+        echo "  - Not rejected\n";
+    } catch (Llhttp\Exception $e) {
+        echo "  - Rejected: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n7. Rejecting a body consumed by form decoding:\n";
+    $form = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST, ['parseForm' => true]);
+    $form->parse("POST / HTTP/1.1\r\nHost: a\r\nContent-Type: application/x-www-form-urlencoded\r\nContent-Length: 3\r\n\r\na=1");
+    try {
+        Llhttp\RequestWriter::fromParser($form);
+        echo "  - Not rejected\n";
+    } catch (Llhttp\Exception $e) {
+        echo "  - Rejected: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n=== RequestWriter test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
@@ -0,0 +1,97 @@
+<?php
+
+use Llhttp\Server;
+
+echo "=== Testing native server core ===\n";
+
+if (!class_exists(Server::class)) {
+    echo "Server requires epoll, skipping\n";
+    return;
+}
+
+function pollUntil(Server $server, int $count): array {
+    $messages = [];
+    for ($i = 0; $i < 50 && count($messages) < $count; $i++) {
+        $messages = array_merge($messages, $server->poll(100));
+    }
+    return $messages;
+}
+
+try {
+    $server = new Server('127.0.0.1', 0, ['maxHeaders' => 16]);
+    echo "Listening: " . ($server->getPort() > 0 ? 'Yes' : 'No') . "\n";
+
+    $client = stream_socket_client('tcp://127.0.0.1:' . $server->getPort());
+
+    // Two pipelined keep-alive requests, the second split across writes
+    fwrite($client, "GET /one HTTP/1.1\r\nHost: x\r\n\r\nPOST /two HTTP/1.1\r\nHost: x\r\n");
+    $messages = pollUntil($server, 1);
+    fwrite($client, "Content-Length: 5\r\n\r\nhello");
+    $messages = array_merge($messages, pollUntil($server, 1));
+
+    foreach ($messages as $message) {
+        echo "Request " . $message['method'] . " " . $message['url'] . " HTTP/" . $message['version'];
+        echo " host=" . $message['headers']['host'] . " body='" . $message['body'] . "'";
+        echo " keepAlive=" . ($message['keepAlive'] ? 'Yes' : 'No') . "\n";
+        $server->send($message['id'], "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok");
+    }
+
+    $response = '';
+    while (substr_count($response, "\r\n\r\nok") < 2 && !feof($client)) {
+        $response .= fread($client, 8192);
+    }
+    echo "Responses: " . substr_count($response, "HTTP/1.1 200 OK") . "\n";
+    echo "Connections: " . $server->getConnectionCount() . "\n";
+
+    // Connection: close ends the connection once the reply is written
+    fwrite($client, "GET /last HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+    $messages = pollUntil($server, 1);
+    echo "Last keepAlive: " . ($messages[0]['keepAlive'] ? 'Yes' : 'No') . "\n";
+    $server->send($messages[0]['id'], "HTTP/1.1 204 No Content\r\n\r\n");
+    echo "Reply: " . trim(stream_get_contents($client)) . "\n";
+    echo "Connections after close: " . $server->getConnectionCount() . "\n";
+
+    // A client that half-closes after its request still gets the reply
+    $half = stream_socket_client('tcp://127.0.0.1:' . $server->getPort());
+    fwrite($half, "GET /half HTTP/1.1\r\nHost: x\r\nConnection: close\r\n\r\n");
+    stream_socket_shutdown($half, STREAM_SHUT_WR);
+    $messages = pollUntil($server, 1);
+    $server->poll(100);
+    $server->send($messages[0]['id'], "HTTP/1.1 204 No Content\r\n\r\n");
+    echo "Half-closed reply: " . trim(stream_get_contents($half)) . "\n";
+
+    // Limits default to finite values for untrusted peers
+    $big = stream_socket_client('tcp://127.0.0.1:' . $server->getPort());
+    fwrite($big, "GET /" . str_repeat('a', 9000) . " HTTP/1.1\r\nHost: x\r\n\r\n");
+    echo "Oversized messages: " . count(pollUntil($server, 1)) . "\n";
+    echo "Oversized reply: " . strtok(stream_get_contents($big), "\r\n") . "\n";
+
+    // Malformed requests get a 400 and never reach PHP
+    $bad = stream_socket_client('tcp://127.0.0.1:' . $server->getPort());
+    fwrite($bad, "NOT HTTP\r\n\r\n");
+    echo "Bad messages: " . count(pollUntil($server, 1)) . "\n";
+    echo "Bad reply: " . strtok(stream_get_contents($bad), "\r\n") . "\n";
+
+    // A malformed request pipelined behind a valid one is answered only after it
+    $mixed = stream_socket_client('tcp://127.0.0.1:' . $server->getPort());
+    fwrite($mixed, "GET /a HTTP/1.1\r\nHost: x\r\n\r\nBROKEN\r\n\r\n");
+    $messages = pollUntil($server, 1);
+    echo "Mixed messages: " . count($messages) . "\n";
+    echo "Mixed send: " . ($server->send($messages[0]['id'], "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok") ? 'Yes' : 'No') . "\n";
+    $reply = stream_get_contents($mixed);
+    echo "Mixed replies: " . implode(', ', array_map(
+        fn ($line) => substr($line, 9),
+        preg_grep('/^HTTP\/1\.1 /', explode("\r\n", $reply))
+    )) . "\n";
+
+    try {
+        new Server('not an address');
+    } catch (Llhttp\Exception $e) {
+        echo "Invalid address: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n=== Server test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
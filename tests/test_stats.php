@@ -0,0 +1,52 @@
+<?php
+
+use Llhttp\Parser;
+use Llhttp\Stats;
+
+echo "=== Testing stats counters ===\n";
+
+try {
+    Stats::reset();
+    $stats = Stats::get();
+    echo "Messages after reset: " . $stats['messages'] . "\n";
+
+    $request = "POST /submit HTTP/1.1\r\nHost: example.com\r\nContent-Length: 4\r\n\r\ntest";
+    $parser = new Parser(Parser::TYPE_REQUEST);
+    $parser->parse($request);
+    $parser->parse($request);
+
+    $stats = Stats::get();
+    echo "Messages: " . $stats['messages'] . "\n";
+    echo "Bytes: " . ($stats['bytes'] === 2 * strlen($request) ? 'match' : $stats['bytes']) . "\n";
+    echo "Body bytes: " . $stats['bodyBytes'] . "\n";
+    echo "Small header bucket: " . $stats['headerCounts']['0-7'] . "\n";
+
+    try {
+        (new Parser(Parser::TYPE_REQUEST))->parse("BOGUS\x01 / HTTP/1.1\r\n\r\n");
+    } catch (Llhttp\Exception $e) {
+    }
+    $stats = Stats::get();
+    echo "Error count: " . $stats['errorCount'] . "\n";
+    echo "Errors by name: " . implode(', ', array_keys($stats['errors'])) . "\n";
+
+    // Cache counters follow the caches
+    $head = "GET / HTTP/1.1\r\nHost: example.com\r\nAccept: text/html\r\n\r\n";
+    foreach ([1, 2] as $i) {
+        $parser = new Parser(Parser::TYPE_REQUEST, ['cacheHeads' => true]);
+        $parser->parse($head);
+        $parser->negotiate('Accept', ['text/html']);
+    }
+    $stats = Stats::get();
+    echo "Head cache: " . $stats['headCacheHits'] . " hit, " . $stats['headCacheMisses'] . " miss\n";
+    echo "Negotiate cache: " . $stats['negotiateCacheHits'] . " hit, " . $stats['negotiateCacheMisses'] . " miss\n";
+
+    ob_start();
+    phpinfo(INFO_MODULES);
+    $info = ob_get_clean();
+    echo "phpinfo shows counters: " . (strpos($info, 'Messages parsed') !== false ? 'Yes' : 'No') . "\n";
+
+    echo "\n=== Stats test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
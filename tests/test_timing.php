@@ -0,0 +1,43 @@
+<?php
+
+use Llhttp\Parser;
+
+echo "=== Testing parser timing ===\n";
+
+try {
+    $parser = new Parser(Parser::TYPE_REQUEST);
+    $timing = $parser->getTiming();
+    echo "Initial phase: " . $timing['phase'] . "\n";
+    echo "Initial first byte: " . var_export($timing['firstByteAt'], true) . "\n";
+
+    $before = hrtime(true);
+    $parser->parse("POST /upload HTTP/1.1\r\nHost: example.com\r\n");
+    $timing = $parser->getTiming();
+    echo "Phase while trickling headers: " . $timing['phase'] . "\n";
+    echo "First byte on hrtime clock: " . ($timing['firstByteAt'] >= $before && $timing['firstByteAt'] <= hrtime(true) ? 'Yes' : 'No') . "\n";
+
+    usleep(2000);
+    $parser->parse("Content-Length: 5\r\n\r\nab");
+    $timing = $parser->getTiming();
+    echo "Phase in body: " . $timing['phase'] . "\n";
+    echo "Progress advanced: " . ($timing['lastProgressAt'] > $timing['firstByteAt'] ? 'Yes' : 'No') . "\n";
+
+    $parser->parse("cde");
+    $timing = $parser->getTiming();
+    echo "Phase after body: " . $timing['phase'] . "\n";
+    echo "Header data bytes: " . $timing['headerDataBytes'] . "\n";
+    echo "Body bytes: " . $timing['bodyBytes'] . "\n";
+    echo "Total bytes: " . $timing['totalBytes'] . "\n";
+
+    // A slow-client check an event loop could run
+    $idleFor = hrtime(true) - $timing['lastProgressAt'];
+    echo "Idle time non-negative: " . ($idleFor >= 0 ? 'Yes' : 'No') . "\n";
+
+    $parser->reset();
+    echo "Phase after reset: " . $parser->getTiming()['phase'] . "\n";
+
+    echo "\n=== Timing test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
@@ -0,0 +1,47 @@
+<?php
+
+use Llhttp\Parser;
+
+echo "=== Testing event trace ===\n";
+
+try {
+    // Off by default
+    $parser = new Parser(Parser::TYPE_REQUEST);
+    $parser->parse("GET / HTTP/1.1\r\n\r\n");
+    echo "Untraced events: " . count($parser->getTrace()) . "\n";
+
+    $parser = new Parser(Parser::TYPE_REQUEST, ['trace' => 32]);
+    $parser->parse("POST /a HTTP/1.1\r\nHost: x\r\n");
+    $parser->parse("Content-Length: 2\r\n\r\nok");
+    foreach ($parser->getTrace() as $event) {
+        echo $event['event'] . " @" . ($event['offset'] ?? '-') . " +" . $event['length'] . "\n";
+    }
+
+    // The ring keeps only the newest events
+    $parser = new Parser(Parser::TYPE_REQUEST, ['trace' => 4]);
+    $parser->parse("GET / HTTP/1.1\r\nA: 1\r\nB: 2\r\n\r\n");
+    $trace = $parser->getTrace();
+    echo "Ring size: " . count($trace) . "\n";
+    echo "Last event: " . end($trace)['event'] . "\n";
+
+    // The trace survives the exception for post-mortem inspection
+    $parser = new Parser(Parser::TYPE_REQUEST, ['trace' => 16]);
+    try {
+        $parser->parse("GET / HTTP/1.1\r\nBad Header: x\r\n\r\n");
+    } catch (Llhttp\Exception $e) {
+        $trace = $parser->getTrace();
+        $last = end($trace);
+        echo "Error event: " . $last['event'] . " at offset " . $last['offset'] . ", code " . $last['code'] . "\n";
+    }
+
+    try {
+        new Parser(Parser::TYPE_REQUEST, ['trace' => 1000000]);
+    } catch (Llhttp\Exception $e) {
+        echo "Oversized trace: " . $e->getMessage() . "\n";
+    }
+
+    echo "\n=== Trace test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
@@ -0,0 +1,32 @@
+<?php
+
+echo "=== Testing trailer collection ===\n";
+
+try {
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_RESPONSE);
+
+    $response = "HTTP/1.1 200 OK\r\n" .
+                "Content-Type: application/grpc\r\n" .
+                "Transfer-Encoding: chunked\r\n" .
+                "Trailer: grpc-status, grpc-message\r\n" .
+                "\r\n" .
+                "4\r\ndata\r\n" .
+                "0\r\n" .
+                "Grpc-Status: 0\r\n" .
+                "Grpc-Message: all good\r\n" .
+                "\r\n";
+
+    // Split mid-name and mid-value to exercise span accumulation
+    foreach (str_split($response, 5) as $piece) {
+        $parser->parse($piece);
+    }
+
+    echo "Headers: " . json_encode($parser->getHeaders()) . "\n";
+    echo "Trailers: " . json_encode($parser->getTrailers()) . "\n";
+    echo "Body: " . $parser->getBody() . "\n";
+
+    echo "\n=== Trailer test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}
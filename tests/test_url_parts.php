@@ -0,0 +1,32 @@
+<?php
+
+echo "=== Testing URL components ===\n";
+
+$targets = [
+    "GET /search?q=llhttp&page=2 HTTP/1.1\r\nHost: example.com\r\n\r\n",
+    "GET http://user@example.com:8080/proxy/path?x=1 HTTP/1.1\r\nHost: example.com\r\n\r\n",
+    "CONNECT example.com:443 HTTP/1.1\r\nHost: example.com:443\r\n\r\n",
+    "OPTIONS * HTTP/1.1\r\nHost: example.com\r\n\r\n",
+];
+
+try {
+    foreach ($targets as $request) {
+        $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+        $parser->parse($request);
+
+        echo $parser->getMethodName() . " " . $parser->getUrl() . "\n";
+        echo "  " . json_encode($parser->getUrlParts()) . "\n";
+    }
+
+    // Offsets index getUrl() without copying components
+    $parser = new Llhttp\Parser(Llhttp\Parser::TYPE_REQUEST);
+    $parser->parse($targets[0]);
+    $parts = $parser->getUrlParts(true);
+    [$offset, $length] = $parts['path'];
+    echo "Path by offset: " . substr($parser->getUrl(), $offset, $length) . "\n";
+
+    echo "\n=== URL components test completed successfully! ===\n";
+
+} catch (Exception $e) {
+    echo "Error: " . $e->getMessage() . "\n";
+}